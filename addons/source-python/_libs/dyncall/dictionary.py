@@ -9,8 +9,10 @@ from configobj import ConfigObj
 
 # Source.Python Imports
 from core import GAME_NAME
+from loggers import _SPLogger
 from paths import DATA_PATH
 #   DynCall
+from dyncall.signature import SIGNATURE_KEY
 from dyncall.signature import Signature
 
 
@@ -20,6 +22,9 @@ from dyncall.signature import Signature
 # Store the game's ini file's path
 _inipath = DATA_PATH.joinpath('dyncall', GAME_NAME)
 
+# Get the sp.dyncall logger
+DynCallLogger = _SPLogger.dyncall
+
 
 # =============================================================================
 # >> CLASSES
@@ -36,6 +41,15 @@ class _SignatureDictionary(dict):
         # Loop through all functions
         for function in sigs:
 
+            # Is the function unavailable on the current platform?
+            if not SIGNATURE_KEY in sigs[function]:
+
+                # Log the missing function and skip it
+                DynCallLogger.log_info(
+                    'No "{0}" for "{1}" on this platform'.format(
+                        SIGNATURE_KEY, function))
+                continue
+
             # Add the function to the dictionary
             self[sigs[function]['shortname']] = Signature(sigs[function])
 
@@ -22,6 +22,13 @@ from dyncall.base import DynCallVM
 from dyncall.modules import ModuleData
 
 
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Store the key used to find functions on the current platform
+SIGNATURE_KEY = 'sig' if os_name == 'nt' else 'symbol'
+
+
 # =============================================================================
 # >> CLASSES
 # =============================================================================
@@ -49,6 +56,13 @@ class Signature(object):
         # Get the module instance
         module = ModuleData[module]
 
+        # Is the function unavailable on the current platform?
+        if not SIGNATURE_KEY in ini:
+
+            # Raise an error about the missing signature/symbol
+            raise NotImplementedError(
+                'No "{0}" given for this platform'.format(SIGNATURE_KEY))
+
         # Is the server running on Windows?
         if os_name == 'nt':
 
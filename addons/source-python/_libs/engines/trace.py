@@ -0,0 +1,44 @@
+# ../_libs/engines/trace.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+from trace_c import get_engine_trace
+from trace_c import CEntityTraceFilter
+from trace_c import MASK_ALL
+from trace_c import MASK_SOLID
+from trace_c import MASK_PLAYERSOLID
+from trace_c import MASK_NPCSOLID
+from trace_c import MASK_OPAQUE
+from trace_c import MASK_VISIBLE
+from trace_c import MASK_SHOT
+from trace_c import MASK_SHOT_HULL
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Add all the global variables to __all__
+__all__ = [
+    'EngineTrace',
+    'EntityTraceFilter',
+    'MASK_ALL',
+    'MASK_SOLID',
+    'MASK_PLAYERSOLID',
+    'MASK_NPCSOLID',
+    'MASK_OPAQUE',
+    'MASK_VISIBLE',
+    'MASK_SHOT',
+    'MASK_SHOT_HULL',
+]
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Get the CEngineTrace instance
+EngineTrace = get_engine_trace()
+
+# Filters are created once and reused across traces
+EntityTraceFilter = CEntityTraceFilter
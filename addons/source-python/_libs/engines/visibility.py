@@ -0,0 +1,23 @@
+# ../_libs/engines/visibility.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+from engine_c import get_visibility_cache
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Add all the global variables to __all__
+__all__ = [
+    'VisibilityCache',
+]
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Get the CVisibilityCache instance
+VisibilityCache = get_visibility_cache()
@@ -0,0 +1,67 @@
+# ../_libs/entities/damage.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Site Package Imports
+#   ConfigObj
+from configobj import ConfigObj
+
+# Source.Python Imports
+from core import GAME_NAME
+from entity_c import DamageAction
+from entity_c import get_damage_manager
+from loggers import _SPLogger
+from paths import DATA_PATH
+#   DynCall
+from dyncall.dictionary import SignatureDictionary
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Add all the global variables to __all__
+__all__ = [
+    'DamageAction',
+    'DamageManager',
+]
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Get the CDamageManager instance
+DamageManager = get_damage_manager()
+
+# Get the sp.entities.damage logger
+DamageLogger = _SPLogger.entities.damage
+
+_entity_values = ConfigObj(
+    DATA_PATH.joinpath('entities', GAME_NAME + '.ini'), unrepr=True)
+
+# Are the CTakeDamageInfo offsets known for this game?
+if 'damage' in _entity_values:
+
+    # Get the offsets
+    _damage = _entity_values['damage']
+
+    # Pass the offsets of the natively read members
+    DamageManager.set_info_offsets(
+        _damage.get('hInflictor', -1), _damage.get('hAttacker', -1),
+        _damage.get('hWeapon', -1), _damage.get('flDamage', -1),
+        _damage.get('bitsDamageType', -1))
+
+# Is CBaseEntity::TakeDamage known for this game and platform?
+if 'TakeDamage' in SignatureDictionary:
+
+    # Let the C++ side hook the function when the first rule is added
+    DamageManager.set_take_damage_function(
+        SignatureDictionary['TakeDamage'].address)
+
+# Is the function unknown?
+else:
+
+    # Log that damage rules can't be added
+    DamageLogger.log_warning(
+        'TakeDamage is not available for this game/platform, '
+        'damage rules can not be added.')
@@ -0,0 +1,35 @@
+# ../_libs/entities/datamaps.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Site Package Imports
+#   ConfigObj
+from configobj import ConfigObj
+
+# Source.Python Imports
+from core import GAME_NAME
+from entity_c import set_datamap_vtable_index
+from paths import DATA_PATH
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Set all to an empty list
+__all__ = []
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+_entity_values = ConfigObj(
+    DATA_PATH.joinpath('entities', GAME_NAME + '.ini'), unrepr=True)
+
+# Is the GetDataDescMap vtable index known for this game?
+if ('datamap' in _entity_values
+        and 'GetDataDescMap' in _entity_values['datamap']):
+
+    # Let the C++ side walk datamaps using the index.
+    # The linux offset is added natively, like with get_virtual_func.
+    set_datamap_vtable_index(_entity_values['datamap']['GetDataDescMap'])
@@ -0,0 +1,20 @@
+# ../_libs/entities/datastore.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+from entity_c import DataStoreFieldType
+from entity_c import DataStoreScope
+from entity_c import get_data_store
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Add all the global variables to __all__
+__all__ = [
+    'DataStoreFieldType',
+    'DataStoreScope',
+    'get_data_store',
+]
@@ -4,10 +4,13 @@
 # >> IMPORTS
 # =============================================================================
 # Source.Python Imports
-#from Source import Binutils
-from entity_c import CEdict
+from entity_c import CEntityAttribute
+from entity_c import get_cached_edict
+from entity_c import EntityAttributeSource
+from memory_c import CPointer
 from public import public
 #   Entities
+import entities.datamaps
 #from entities.functions import Functions
 from entities.keyvalues import KeyValues
 from entities.offsets import Offsets
@@ -31,23 +34,26 @@ class BaseEntity(object):
         '''Override the __new__ class method to verify the given index
             is of the correct entity type and add the index attribute'''
 
-        # Get the given indexes edict
-        edict = CEdict(index)
+        # Get the given index's shared edict instance
+        edict = get_cached_edict(index)
 
         # Is the edict valid?
-        if edict.is_free() or not edict.is_valid():
+        if edict is None or not edict.is_valid():
 
             # If not raise an error
             raise ValueError(
                 'Index "{0}" is not a proper entity index'.format(index))
 
-        # Create the object
-        self = object.__new__(cls)
+        # Get the entity types of the object
+        entities = frozenset(list(entities) + ['entity'])
+
+        # Create the object using the class with native attributes
+        self = object.__new__(_get_entity_class(cls, entities))
 
         # Set the entity's base attributes
         self.index = index
         self.edict = edict
-        self._entities = frozenset(list(entities) + ['entity'])
+        self._entities = entities
 
         # Return the instance
         return self
@@ -129,23 +135,31 @@ class BaseEntity(object):
         '''Gets the value of the given keyvalue'''
 
         # Return the value of the given keyvalue
-        return self.edict.GetKeyValue(item)
+        return self.edict.get_keyvalue(item)
 
     def _get_offset(self, item):
-        '''Gets teh value of the given offset'''
+        '''Gets the value of the given offset'''
+
+        # Get the offset's instance
+        offset = self.offsets[item]
+
+        # Is the offset resolved from the entity's datamap?
+        if offset.attribute is not None:
 
-        # Get the offset's type
-        offset_type = self.offsets[item].type
+            # Return the datamap field's value
+            return offset.attribute.__get__(self, type(self))
+
+        # Get the entity's pointer
+        pointer = CPointer(self.pointer)
 
         # Is the offset's type a known type?
-        if not hasattr(Binutils, 'GetLoc{0}'.format(offset_type)):
+        if not hasattr(pointer, offset.getter):
 
             # If not a proper type, raise an error
-            raise TypeError('Invalid offset type "{0}"'.format(offset_type))
+            raise TypeError('Invalid offset type "{0}"'.format(offset.type))
 
         # Return the value of the offset
-        return getattr(Binutils, 'GetLoc{0}'.format(offset_type))(
-            self.pointer + self.offsets[item].offset)
+        return getattr(pointer, offset.getter)(offset.offset)
 
     def _get_function(self, item):
         '''Calls a dynamic function'''
@@ -165,16 +179,8 @@ class BaseEntity(object):
         # Does the class have the given attribute?
         if hasattr(self.__class__, attr):
 
-            # Is this an inherited class?
-            if self.__class__ != BaseEntity:
-
-                # Get the attribute and set its value
-                getattr(self.__class__, attr).fset(self, value)
-
-                # No need to go further
-                return
-
-            # Set the attribute
+            # Set the attribute (this also uses
+            # properties and native entity attributes)
             object.__setattr__(self, attr, value)
 
             # No need to go further
@@ -244,33 +250,35 @@ class BaseEntity(object):
     def _set_keyvalue(self, item, value):
         '''Sets the value of the given keyvalue'''
 
-        # Get the keyvalue's type
-        kv_type = self.keyvalues[item]
+        # Set the keyvalue's value (the type is resolved natively)
+        self.edict.set_keyvalue(item, value)
+
+    def _set_offset(self, item, value):
+        '''Sets the value of the given offset'''
 
-        # Is the keyvalue's type a known type?
-        if not hasattr(self.edict, 'SetKeyValue{0}'.format(kv_type)):
+        # Get the offset's instance
+        offset = self.offsets[item]
 
-            # Raise an error
-            raise TypeError('Invalid keyvalue type "{0}"'.format(kv_type))
+        # Is the offset resolved from the entity's datamap?
+        if offset.attribute is not None:
 
-        # Set the keyvalue's value
-        getattr(self.edict, 'SetKeyValue{0}'.format(kv_type))(item, value)
+            # Set the datamap field's value
+            offset.attribute.__set__(self, value)
 
-    def _set_offset(self, item, value):
-        '''Sets the value of the given offset'''
+            # No need to go further
+            return
 
-        # Get the offset's type
-        offset_type = self.offsets[item].type
+        # Get the entity's pointer
+        pointer = CPointer(self.pointer)
 
         # Is the offset's type a known type?
-        if not hasattr(Binutils, 'SetLoc{0}'.format(offset_type)):
+        if not hasattr(pointer, offset.setter):
 
             # If not a proper type, raise an error
-            raise TypeError('Invalid offset type "{0}"'.format(offset_type))
+            raise TypeError('Invalid offset type "{0}"'.format(offset.type))
 
         # Set the offset's value
-        getattr(Binutils, 'SetLoc{0}'.format(offset_type))(
-            self.pointer + self.offsets[item].offset, value)
+        getattr(pointer, offset.setter)(value, offset.offset)
 
     def get_color(self):
         '''Returns a 4 part tuple (RGBA) for the entity's color'''
@@ -327,6 +335,12 @@ class BaseEntity(object):
     # Set the "color" property for BaseEntity
     color = property(get_color, set_color)
 
+    def set_keyvalues(self, keyvalues):
+        '''Sets all keyvalues of the given dictionary at once'''
+
+        # Set all keyvalues with a single call
+        self.edict.set_keyvalues(keyvalues)
+
     @property
     def instances(self):
         '''Yields the entity's edict instance'''
@@ -372,3 +386,59 @@ class BaseEntity(object):
     def functions(self):
         '''Returns all dynamic calling functions for all entities'''
         return Functions.get_entity_functions(self._entities)
+
+
+# =============================================================================
+# >> FUNCTIONS
+# =============================================================================
+# Store the classes with native attributes by class and entity types
+_entity_classes = {}
+
+
+def _get_entity_class(cls, entities):
+    '''Returns a subclass of the given class with a native
+        attribute for each property and datamap offset'''
+
+    # Was the class already created?
+    if (cls, entities) in _entity_classes:
+
+        # Return the class
+        return _entity_classes[cls, entities]
+
+    # Create an empty dictionary to store the attributes
+    attributes = dict()
+
+    # Loop through all properties for the given entities
+    for name, prop in Properties.get_entity_properties(entities).items():
+
+        # Does the class already define the attribute?
+        if hasattr(cls, name):
+            continue
+
+        # Create the attribute
+        attributes[name] = CEntityAttribute(
+            prop.prop, EntityAttributeSource.ATTRIBUTE_SENDPROP, prop.type)
+
+        # Is the property a True/False property?
+        if 'True' in prop:
+
+            # Set the values to compare against
+            attributes[name].set_bool_values(prop['True'], prop['False'])
+
+    # Loop through all offsets for the given entities
+    for name, offset in Offsets.get_entity_offsets(entities).items():
+
+        # Is the offset not a datamap field or
+        # does the class already define the attribute?
+        if offset.attribute is None or hasattr(cls, name):
+            continue
+
+        # Use the offset's attribute
+        attributes[name] = offset.attribute
+
+    # Create the class
+    entity_class = _entity_classes[cls, entities] = type(
+        cls.__name__, (cls, ), attributes)
+
+    # Return the class
+    return entity_class
@@ -5,8 +5,9 @@
 # =============================================================================
 # Source.Python Imports
 from entity_c import CBaseEntityHandle
-from entity_c import CEdict
+from entity_c import get_cached_edict
 from entity_c import index_of_pointer
+from entity_c import indexes_from_inthandles
 from public import public
 
 
@@ -31,6 +32,13 @@ def index_from_inthandle(ihandle):
     return index_from_basehandle(basehandle_from_inthandle(ihandle))
 
 
+@public
+def index_list_from_inthandles(ihandles):
+    '''Returns a list of indexes from the given handles in int form.
+        Stale handles are returned as -1'''
+    return indexes_from_inthandles(ihandles)
+
+
 @public
 def index_from_pointer(pointer):
     '''Returns an index from the given BaseEntity pointer'''
@@ -40,7 +48,7 @@ def index_from_pointer(pointer):
 @public
 def edict_from_index(index):
     '''Returns an edict from the given index'''
-    return CEdict(index)
+    return get_cached_edict(index)
 
 
 @public
@@ -0,0 +1,23 @@
+# ../_libs/entities/lump.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+from entity_c import get_map_entity_lump
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Add all the global variables to __all__
+__all__ = [
+    'MapEntityLump',
+]
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Get the CMapEntityLump instance
+MapEntityLump = get_map_entity_lump()
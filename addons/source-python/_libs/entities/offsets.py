@@ -13,6 +13,8 @@ from configobj import ConfigObj
 
 # Source.Python Imports
 from core import GAME_NAME
+from entity_c import CEntityAttribute
+from entity_c import EntityAttributeSource
 from paths import DATA_PATH
 
 
@@ -67,11 +69,21 @@ Offsets = _Offsets()
 class _OffsetInstance(object):
     '''Class used to store an offset by its value and type'''
 
-    def __init__(self, offset, offset_type):
-        '''Stores the offset and type'''
+    def __init__(self, offset, offset_type, datamap=None):
+        '''Stores the offset, type and datamap field name'''
 
         self.offset = offset
         self.type = offset_type
+        self.datamap = datamap
+
+        # Store the CPointer method names, so they aren't built per access
+        self.getter = 'get_{0}'.format(offset_type.lower())
+        self.setter = 'set_{0}'.format(offset_type.lower())
+
+        # Datamap fields are read through a native attribute,
+        # which caches the field's offset per entity class
+        self.attribute = None if datamap is None else CEntityAttribute(
+            datamap, EntityAttributeSource.ATTRIBUTE_DATAMAP, offset_type)
 
 
 # =============================================================================
@@ -98,6 +110,16 @@ def _get_all_entity_offsets(entity):
     # Loop through all items in the file
     for key in ini:
 
+        # Is the offset resolved from the entity's datamap?
+        if 'datamap' in ini[key]:
+
+            # Add the item to the dictionary
+            game_offsets[key] = _OffsetInstance(
+                None, ini[key]['type'], ini[key]['datamap'])
+
+            # No need to go further
+            continue
+
         # Get the offset for the Operating System
         offset = ini[key].get(os_name, ini[key]['linux'])
 
@@ -0,0 +1,44 @@
+# ../_libs/entities/outputs.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+from entity_c import get_output_listener_manager
+from loggers import _SPLogger
+#   DynCall
+from dyncall.dictionary import SignatureDictionary
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Add all the global variables to __all__
+__all__ = [
+    'OutputListenerManager',
+]
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Get the COutputListenerManager instance
+OutputListenerManager = get_output_listener_manager()
+
+# Get the sp.entities.outputs logger
+OutputsLogger = _SPLogger.entities.outputs
+
+# Is CBaseEntityOutput::FireOutput known for this game and platform?
+if 'FireOutput' in SignatureDictionary:
+
+    # Let the C++ side hook the function when the first listener is added
+    OutputListenerManager.set_fire_output_function(
+        SignatureDictionary['FireOutput'].address)
+
+# Is the function unknown?
+else:
+
+    # Log that listeners can't be registered
+    OutputsLogger.log_warning(
+        'FireOutput is not available for this game/platform, '
+        'output listeners can not be registered.')
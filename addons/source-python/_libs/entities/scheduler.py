@@ -0,0 +1,23 @@
+# ../_libs/entities/scheduler.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+from entity_c import get_entity_scheduler
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Add all the global variables to __all__
+__all__ = [
+    'EntityScheduler',
+]
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Get the CEntityScheduler instance
+EntityScheduler = get_entity_scheduler()
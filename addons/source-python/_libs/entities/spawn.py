@@ -0,0 +1,23 @@
+# ../_libs/entities/spawn.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+from entity_c import get_entity_spawn_queue
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Add all the global variables to __all__
+__all__ = [
+    'EntitySpawnQueue',
+]
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Get the CEntitySpawnQueue instance
+EntitySpawnQueue = get_entity_spawn_queue()
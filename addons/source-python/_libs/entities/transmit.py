@@ -0,0 +1,23 @@
+# ../_libs/entities/transmit.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+from entity_c import get_transmit_manager
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Add all the global variables to __all__
+__all__ = [
+    'TransmitManager',
+]
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Get the CTransmitManager instance
+TransmitManager = get_transmit_manager()
@@ -9,7 +9,8 @@ from configobj import ConfigObj
 
 # Source.Python Imports
 from player_c import CPlayerGenerator
-from core import GameEngine
+from player_c import get_cached_playerinfo
+from player_c import get_player_filter_masks
 from core import GAME_NAME
 from paths import DATA_PATH
 from public import public
@@ -17,6 +18,7 @@ from public import public
 from filters.iterator import _IterObject
 from filters.manager import _BaseFilterManager
 #   Players
+from players.convars import ClientConVarCache
 from players.entity import PlayerEntity
 from players.helpers import address_from_playerinfo
 from players.helpers import basehandle_from_playerinfo
@@ -35,6 +37,12 @@ from players.helpers import userid_from_playerinfo
 _game_teams = ConfigObj(
     DATA_PATH.joinpath('players', 'teams', GAME_NAME + '.ini'), unrepr=True)
 
+# Get the CPlayerFilterMasks instance
+_PlayerFilterMasks = get_player_filter_masks()
+
+# Store the filter functions that the native masks can replace
+_native_filters = dict()
+
 
 # =============================================================================
 # >> MAIN PLAYER ITER CLASSES
@@ -56,6 +64,69 @@ class PlayerIter(_IterObject):
     # Store the base iterator
     iterator = staticmethod(CPlayerGenerator)
 
+    def __iter__(self):
+        '''Iterates through the players using the native filter
+            masks if all filters are the built-in ones'''
+
+        # Get the matching indexes from the native masks
+        indexes = self._get_native_indexes()
+
+        # Are any of the filters not resolved natively?
+        if indexes is None:
+
+            # Use the Python filters
+            yield from super(PlayerIter, self).__iter__()
+            return
+
+        # Are the indexes the only return type?
+        if self._return_types == 'index':
+
+            # Yield the indexes without any Python calls per player
+            yield from indexes
+            return
+
+        # Loop through the matching indexes
+        for index in indexes:
+
+            # Get the player's shared CPlayerInfo instance
+            playerinfo = get_cached_playerinfo(index)
+
+            # Is the player no longer on the server?
+            if playerinfo is None:
+                continue
+
+            # Are the return types a string?
+            if isinstance(self._return_types, str):
+
+                # Yield the proper type for the current player
+                yield self.manager._return_types[
+                    self._return_types](playerinfo)
+
+            # Otherwise
+            else:
+
+                # Yield the list of return types for the current player
+                yield [self.manager._return_types[return_type](playerinfo)
+                    for return_type in self._return_types]
+
+    def _get_native_indexes(self):
+        '''Returns the indexes of the matching players
+            or None if a filter is not a built-in one'''
+
+        # Loop through all filters
+        for filter_name in (
+                list(self._is_filters) + list(self._not_filters)):
+
+            # Was the filter replaced or added by another script?
+            if (filter_name not in _native_filters or
+                    self.manager._filters.get(filter_name) is not
+                    _native_filters[filter_name]):
+                return None
+
+        # Return the indexes of the native masks
+        return _PlayerFilterMasks.get_indexes(
+            self._is_filters, self._not_filters)
+
 
 # =============================================================================
 # PLAYER TEAM CLASSES
@@ -107,7 +178,7 @@ def _player_is_bot(CPlayerInfo):
 
 def _player_is_human(CPlayerInfo):
     '''Returns whether the player is a human'''
-    return CPlayerInfo.is_player()
+    return not CPlayerInfo.is_fake_client()
 
 
 def _player_is_alive(CPlayerInfo):
@@ -119,12 +190,22 @@ def _player_is_dead(CPlayerInfo):
     '''Returns whether the player is dead'''
     return CPlayerInfo.is_dead()
 
+
+def _player_is_hltv(CPlayerInfo):
+    '''Returns whether the player is the HLTV bot'''
+    return CPlayerInfo.is_hltv()
+
+# Store the filter functions that have a native mask
+_native_filters['all'] = _is_player
+_native_filters['bot'] = _player_is_bot
+_native_filters['human'] = _player_is_human
+_native_filters['alive'] = _player_is_alive
+_native_filters['dead'] = _player_is_dead
+_native_filters['hltv'] = _player_is_hltv
+
 # Register the filter functions
-PlayerIterManager.register_filter('all', _is_player)
-PlayerIterManager.register_filter('bot', _player_is_bot)
-PlayerIterManager.register_filter('human', _player_is_human)
-PlayerIterManager.register_filter('alive', _player_is_alive)
-PlayerIterManager.register_filter('dead', _player_is_dead)
+for _filter_name, _filter_function in _native_filters.items():
+    PlayerIterManager.register_filter(_filter_name, _filter_function)
 
 # Loop through all teams in the game's team file
 for team in _game_teams:
@@ -136,6 +217,10 @@ for team in _game_teams:
     PlayerIterManager.register_filter(
         team, _PlayerTeamsInstance[team]._player_is_on_team)
 
+    # Register the team's native mask
+    _native_filters[team] = PlayerIterManager._filters[team]
+    _PlayerFilterMasks.register_team(team, _game_teams[team])
+
 # Loop through all base team names
 for number, team in enumerate(('un', 'spec', 't', 'ct')):
 
@@ -152,6 +237,10 @@ for number, team in enumerate(('un', 'spec', 't', 'ct')):
     PlayerIterManager.register_filter(
         team, _PlayerTeamsInstance[team]._player_is_on_team)
 
+    # Register the team's native mask
+    _native_filters[team] = PlayerIterManager._filters[team]
+    _PlayerFilterMasks.register_team(team, number)
+
 
 # =============================================================================
 # >> RETURN TYPE FUNCTIONS
@@ -213,7 +302,7 @@ def _return_weapon(CPlayerInfo):
 
 def _return_language(CPlayerInfo):
     '''Returns the player's language'''
-    return GameEngine.get_client_convar_value(
+    return ClientConVarCache.get_value(
         index_from_playerinfo(CPlayerInfo), 'cl_language')
 
 
@@ -6,7 +6,6 @@
 # Python Imports
 #   Collections
 from collections import ChainMap
-from collections import defaultdict
 from collections import OrderedDict
 #   ConfigObj
 from configobj import ConfigObj
@@ -18,12 +17,13 @@ from path import path
 
 # Source.Python Imports
 from core import echo_console
-from core import GameEngine
 from excepthooks import ExceptHooks
 #   UserMessage
 from usermessage_c import CUserMessage
 #   Filters
 from filters.recipients import RecipientFilter
+#   Players
+from players.convars import ClientConVarCache
 #   Translations
 from translations.strings import TranslationStrings
 
@@ -540,19 +540,13 @@ class BaseMessage(dict):
         # Any parameter to translate?
         if self._translatable_parameters:
 
-            # Get a default dictionnary to store the players
-            languages = defaultdict(set)
+            # Group the players by language
+            languages = ClientConVarCache.group_by_value(
+                recipient, 'cl_language')
 
             # Get a mapping of the given tokens
             tokens = ChainMap(kwargs, self.tokens)
 
-            # Loop through all indexes
-            for index in recipient:
-
-                # Add the current index
-                languages[GameEngine.get_client_convar_value(index,
-                    'cl_language')].add(index)
-
             # Loop through all languages
             for language, users in languages.items():
 
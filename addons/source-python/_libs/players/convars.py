@@ -0,0 +1,46 @@
+# ../_libs/players/convars.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Python Imports
+#   Concurrent
+from concurrent.futures import Future
+
+# Source.Python Imports
+from player_c import get_client_convar_cache
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Add all the global variables to __all__
+__all__ = [
+    'ClientConVarCache',
+    'query_client_cvars',
+]
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Get the CClientConVarCache instance
+ClientConVarCache = get_client_convar_cache()
+
+
+# =============================================================================
+# >> FUNCTIONS
+# =============================================================================
+def query_client_cvars(indexes, names, timeout=5.0):
+    '''Queries the given cvars of the given players and returns a Future
+        that resolves to a dict {index: {name: value}} on the game thread'''
+
+    # Get a Future to resolve once all answers arrived
+    future = Future()
+    future.set_running_or_notify_cancel()
+
+    # Send the queries
+    ClientConVarCache.query(indexes, names, future.set_result, timeout)
+
+    # Return the Future
+    return future
@@ -4,12 +4,12 @@
 # >> IMPORTS
 # =============================================================================
 # Source.Python Imports
-from player_c import CPlayerInfo
-from core import GameEngine
+from player_c import get_cached_playerinfo
 from public import public
 #   Entities
 from entities.entity import BaseEntity
 #   Players
+from players.convars import ClientConVarCache
 from players.helpers import address_from_playerinfo
 from players.helpers import uniqueid_from_playerinfo
 from players.weapons import _PlayerWeapons
@@ -24,12 +24,16 @@ class PlayerEntity(BaseEntity, _PlayerWeapons):
 
     info = None
 
+    def __new__(cls, index):
+        '''Override the __new__ class method to add
+            the "player" entity type to the object'''
+        return super(PlayerEntity, cls).__new__(cls, index, 'player')
+
     def __init__(self, index):
-        '''Override the __init__ method to set the
-            "entities" attribute and set the PlayerInfo'''
+        '''Override the __init__ method to set the PlayerInfo'''
 
         # Set the player's info attribute
-        self.info = CPlayerInfo(self.edict)
+        self.info = get_cached_playerinfo(self.index)
 
         # Is the IPlayerInfo instance valid?
         if self.info is None:
@@ -37,9 +41,6 @@ class PlayerEntity(BaseEntity, _PlayerWeapons):
             raise ValueError(
                 'Invalid IPlayerInfo instance for index "{0}"'.format(index))
 
-        # Set the entities attribute
-        self._entities = frozenset(['entity', 'player'])
-
     @property
     def instances(self):
         '''Yields the player's IPlayerInfo and Edict instances'''
@@ -69,7 +70,7 @@ class PlayerEntity(BaseEntity, _PlayerWeapons):
     @property
     def language(self):
         '''Returns the player's language'''
-        return GameEngine.get_client_convar_value(self.index, 'cl_language')
+        return ClientConVarCache.get_value(self.index, 'cl_language')
 
     @property
     def uniqueid(self):
@@ -5,7 +5,11 @@
 # =============================================================================
 # Source.Python Imports
 from player_c import CPlayerGenerator
-from player_c import CPlayerInfo
+from player_c import get_cached_playerinfo
+from player_c import index_of_networkid
+from player_c import index_of_uniqueid
+from player_c import index_of_userid
+from player_c import userid_of_index
 from core import GameEngine
 from public import public
 #   Entities
@@ -26,7 +30,16 @@ __all__ = _all
 @public
 def index_from_userid(userid):
     '''Returns an index from the given userid'''
-    return index_from_playerinfo(playerinfo_from_userid(userid))
+
+    # Get the index from the native userid table
+    index = index_of_userid(userid)
+
+    # Raise an error if no player has the userid
+    if index is None:
+        raise ValueError('Invalid userid "{0}"'.format(userid))
+
+    # Return the index
+    return index
 
 
 @public
@@ -38,7 +51,7 @@ def index_from_playerinfo(playerinfo):
 @public
 def edict_from_userid(userid):
     '''Returns an edict from the given userid'''
-    return edict_from_playerinfo(playerinfo_from_userid(userid))
+    return edict_from_index(index_from_userid(userid))
 
 
 @public
@@ -86,7 +99,7 @@ def pointer_from_playerinfo(playerinfo):
 @public
 def userid_from_index(index):
     '''Returns a userid from the given index'''
-    return userid_from_edict(edict_from_index(index))
+    return userid_of_index(index)
 
 
 @public
@@ -122,13 +135,13 @@ def userid_from_playerinfo(playerinfo):
 @public
 def playerinfo_from_index(index):
     '''Returns an IPlayerInfo instance from the given index'''
-    return playerinfo_from_edict(edict_from_index(index))
+    return get_cached_playerinfo(index)
 
 
 @public
 def playerinfo_from_edict(edict):
     '''Returns an IPlayerInfo instance from the given edict'''
-    return CPlayerInfo(edict)
+    return get_cached_playerinfo(edict.get_index())
 
 
 @public
@@ -152,7 +165,7 @@ def playerinfo_from_pointer(pointer):
 @public
 def playerinfo_from_userid(userid):
     '''Returns an IPlayerInfo instance from the given userid'''
-    return CPlayerInfo(userid)
+    return get_cached_playerinfo(index_from_userid(userid))
 
 
 # =============================================================================
@@ -162,34 +175,30 @@ def playerinfo_from_userid(userid):
 def index_from_steamid(steamid):
     '''Returns an index from the given SteamID'''
 
-    # Loop through all players on the server
-    for player in CPlayerGenerator():
-
-        # Is the current player's SteamID the same as the one given?
-        if player.get_networkid_string() == steamid:
-
-            # Return the index of the current player
-            return index_from_playerinfo(player)
+    # Get the index from the native networkid table
+    index = index_of_networkid(steamid)
 
     # If no player found with a matching SteamID, raise an error
-    raise ValueError('Invalid SteamID "{0}"'.format(steamid))
+    if index is None:
+        raise ValueError('Invalid SteamID "{0}"'.format(steamid))
+
+    # Return the index of the player
+    return index
 
 
 @public
 def index_from_uniqueid(uniqueid):
     '''Returns an index from the given UniqueID'''
 
-    # Loop through all players on the server
-    for player in CPlayerGenerator():
-
-        # Is the current player's UniqueID the same as the one given?
-        if uniqueid_from_playerinfo(player) == uniqueid:
-
-            # Return the index of the current player
-            return index_from_playerinfo(player)
+    # Get the index from the native uniqueid table
+    index = index_of_uniqueid(uniqueid)
 
     # If no player found with a matching UniqueID, raise an error
-    raise ValueError('Invalid UniqueID "{0}"'.format(uniqueid))
+    if index is None:
+        raise ValueError('Invalid UniqueID "{0}"'.format(uniqueid))
+
+    # Return the index of the player
+    return index
 
 
 @public
@@ -0,0 +1,29 @@
+# ../_libs/players/netstats.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+from player_c import NETSTAT_HISTORY
+from player_c import NetStatAggregate
+from player_c import NetStatMetric
+from player_c import get_net_channel_sampler
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Add all the global variables to __all__
+__all__ = [
+    'NETSTAT_HISTORY',
+    'NetChannelSampler',
+    'NetStatAggregate',
+    'NetStatMetric',
+]
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Get the CNetChannelSampler instance
+NetChannelSampler = get_net_channel_sampler()
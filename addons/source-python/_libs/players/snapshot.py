@@ -0,0 +1,18 @@
+# ../_libs/players/snapshot.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+from player_c import PlayerSnapshotField
+from player_c import get_player_snapshot
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Add all the global variables to __all__
+__all__ = [
+    'PlayerSnapshotField',
+    'get_player_snapshot',
+]
@@ -0,0 +1,99 @@
+# ../_libs/players/usercmd.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Python Imports
+#   Collections
+from collections import namedtuple
+#   Struct
+from struct import Struct
+
+# Site Package Imports
+#   ConfigObj
+from configobj import ConfigObj
+
+# Source.Python Imports
+from core import GAME_NAME
+from loggers import _SPLogger
+from paths import DATA_PATH
+from player_c import USERCMD_RECORD_FORMAT
+from player_c import UserCmdField
+from player_c import get_usercmd_manager
+#   DynCall
+from dyncall.dictionary import SignatureDictionary
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+# Add all the global variables to __all__
+__all__ = [
+    'UserCmdField',
+    'UserCmdManager',
+    'UserCmdRecord',
+    'iter_usercmd_records',
+]
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Get the CUserCmdManager instance
+UserCmdManager = get_usercmd_manager()
+
+# Get the sp.players.usercmd logger
+UserCmdLogger = _SPLogger.players.usercmd
+
+# Store a named record type for the batch buffer
+UserCmdRecord = namedtuple('UserCmdRecord', [
+    'index', 'command_number', 'tick_count', 'pitch', 'yaw', 'roll',
+    'forward_move', 'side_move', 'up_move', 'buttons', 'impulse',
+    'weapon_select', 'random_seed', 'mouse_dx', 'mouse_dy'])
+
+# Compile the record format once for all batches
+_usercmd_record = Struct(USERCMD_RECORD_FORMAT)
+
+_entity_values = ConfigObj(
+    DATA_PATH.joinpath('entities', GAME_NAME + '.ini'), unrepr=True)
+
+# Are the CUserCmd offsets known for this game?
+if 'usercmd' in _entity_values:
+
+    # Loop through all offsets
+    for _name, _offset in _entity_values['usercmd'].items():
+
+        # Pass the offset of the member
+        UserCmdManager.set_field_offset(
+            getattr(UserCmdField, 'USERCMD_' + _name.upper()), _offset)
+
+# Is PlayerRunCommand known for this game and platform?
+if 'PlayerRunCommand' in SignatureDictionary:
+
+    # Let the C++ side hook the function when it is first needed
+    UserCmdManager.set_run_command_function(
+        SignatureDictionary['PlayerRunCommand'].address)
+
+# Is the function unknown?
+else:
+
+    # Log that usercmds can't be observed. Only Linux has a signature for
+    # the function, so this is always the case on Windows.
+    UserCmdLogger.log_warning(
+        'PlayerRunCommand is not available for this game/platform, '
+        'usercmd callbacks and batches will not be fired.')
+
+
+# =============================================================================
+# >> FUNCTIONS
+# =============================================================================
+def iter_usercmd_records(buffer):
+    '''Yields a UserCmdRecord for every command of a batch buffer'''
+    # Get the size of a single record
+    size = _usercmd_record.size
+
+    # Loop through the offsets of all complete records
+    for offset in range(0, len(buffer) // size * size, size):
+
+        # Yield the record at the offset
+        yield UserCmdRecord._make(_usercmd_record.unpack_from(buffer, offset))
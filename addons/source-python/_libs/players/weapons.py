@@ -4,7 +4,8 @@
 # >> IMPORTS
 # =============================================================================
 # Source.Python Imports
-from entity_c import CEdict
+from entity_c import get_cached_edict
+from player_c import get_weapon_inventory
 from core import GAME_NAME
 #   Entities
 from entities.entity import BaseEntity
@@ -23,6 +24,12 @@ __all__ = []
 # =============================================================================
 # >> GLOBAL VARIALBES
 # =============================================================================
+# Get the CWeaponInventory instance
+WeaponInventory = get_weapon_inventory()
+
+# Store the classnames of weapon filters, since they never change
+_filter_classnames = dict()
+
 # Use try/except to import the _GameWeapons class
 try:
 
@@ -89,12 +96,8 @@ class _PlayerWeapons(_GameWeapons):
             # Return 0 as the amount
             return 0
 
-        # Get the BaseEntity instance for the index
-        weapon = BaseEntity(index, 'weapon')
-
         # Return the amount of ammo the player has for the weapon
-        return self.GetPropInt(
-            WeaponManager.ammoprop + '%03d' % weapon.ammoprop)
+        return WeaponInventory.get_ammo(self.index, index)
 
     # =========================================================================
     # >> GET CLIP
@@ -132,11 +135,8 @@ class _PlayerWeapons(_GameWeapons):
             # Return 0 as the amount
             return 0
 
-        # Get the BaseEntity instance for the index
-        weapon = BaseEntity(index, 'weapon')
-
         # Return the amount of ammo in the weapon's clip
-        return weapon.clip
+        return WeaponInventory.get_clip(index)
 
     # =========================================================================
     # >> SET AMMO
@@ -175,12 +175,8 @@ class _PlayerWeapons(_GameWeapons):
                 '"{0}, {1}, {2}" for player "{3}"'.format(
                     classname, is_filters, not_filters, self.userid))
 
-        # Get the entity's BaseEntity instance
-        weapon = BaseEntity(index, 'weapon')
-
         # Set the player's ammo value
-        self.SetPropInt(
-            WeaponManager.ammoprop + '%03d' % weapon.ammoprop, value)
+        WeaponInventory.set_ammo(self.index, index, value)
 
     # =========================================================================
     # >> SET CLIP
@@ -219,11 +215,8 @@ class _PlayerWeapons(_GameWeapons):
                 '"{0}, {1}, {2}" for player "{3}"'.format(
                     classname, is_filters, not_filters, self.userid))
 
-        # Get the entity's BaseEntity instance
-        weapon = BaseEntity(index, 'weapon')
-
         # Set the weapon's clip value
-        weapon.clip = value
+        WeaponInventory.set_clip(index, value)
 
     # =========================================================================
     # >> ADD AMMO
@@ -262,16 +255,11 @@ class _PlayerWeapons(_GameWeapons):
                 '"{0}, {1}, {2}" for player "{3}"'.format(
                     classname, is_filters, not_filters, self.userid))
 
-        # Get the entity's BaseEntity instance
-        weapon = BaseEntity(index, 'weapon')
-
         # Get the current ammo value
-        current = self.GetPropInt(
-            WeaponManager.ammoprop + '%03d' % weapon.ammoprop)
+        current = WeaponInventory.get_ammo(self.index, index)
 
         # Add ammo to the current value
-        self.SetPropInt(
-            WeaponManager.ammoprop + '%03d' % weapon.ammoprop, current + value)
+        WeaponInventory.set_ammo(self.index, index, current + value)
 
     # =========================================================================
     # >> ADD CLIP
@@ -310,11 +298,11 @@ class _PlayerWeapons(_GameWeapons):
                 '"{0}, {1}, {2}" for player "{3}"'.format(
                     classname, is_filters, not_filters, self.userid))
 
-        # Get the entity's BaseEntity instance
-        weapon = BaseEntity(index, 'weapon')
+        # Get the current clip value
+        current = WeaponInventory.get_clip(index)
 
         # Add ammo to the weapon's clip
-        weapon.clip += value
+        WeaponInventory.set_clip(index, current + value)
 
     # =========================================================================
     # >> WEAPON INDEXES
@@ -330,15 +318,41 @@ class _PlayerWeapons(_GameWeapons):
     def get_weapon_index(self, classname=None, is_filters=[], not_filters=[]):
         '''Returns the first instance of the given weapon classname/type'''
 
-        # Loop through all weapon indexes for
-        # the player with the given arguments
-        for index in self.weapon_indexes(classname, is_filters, not_filters):
+        # Were no weapon types given?
+        if not (is_filters or not_filters):
+
+            # Was a classname given?
+            if classname is not None:
+
+                # Let the inventory find the weapon
+                return WeaponInventory.find_weapon(self.index, classname)
 
-            # Return the first index found
-            return index
+            # Loop through all weapon indexes of the player
+            for index in WeaponInventory.get_weapons(self.index):
 
-        # If no index is found, return None
-        return None
+                # Return the first index found
+                return index
+
+            # If no index is found, return None
+            return None
+
+        # Get the classnames of the given weapon types
+        classnames = _get_filter_classnames(is_filters, not_filters)
+
+        # Was a classname given?
+        if classname is not None:
+
+            # Is the classname not of the given types?
+            if classname not in classnames:
+
+                # Return None, since no weapon can match
+                return None
+
+            # Only look for the given classname
+            classnames = (classname, )
+
+        # Let the inventory find the first matching weapon
+        return WeaponInventory.find_weapon(self.index, tuple(classnames))
 
     def get_weapon_index_list(
             self, classname=None, is_filters=[], not_filters=[]):
@@ -350,29 +364,15 @@ class _PlayerWeapons(_GameWeapons):
             Iterates over all currently held weapons, and yields their indexes
         '''
 
-        # Loop through the length of m_hMyWeapons
-        for offset in range(64):
+        # Get the classnames of the given weapon types
+        if is_filters or not_filters:
+            classnames = _get_filter_classnames(is_filters, not_filters)
 
-            # Get the player's current weapon at this offset
-            handle = self.GetPropInt(WeaponManager.myweapons + '%03i' % offset)
-
-            # Is this an invalid handle?
-            if handle == -1:
-
-                # Move onto the next offset
-                continue
-
-            # Get the weapon's index
-            index = index_from_inthandle(handle)
-
-            # Is this a valid index?
-            if index is None:
-
-                # Move onto the next offset
-                continue
+        # Loop through the indexes of all weapons of the player
+        for index in WeaponInventory.get_weapons(self.index):
 
             # Get the weapon's edict
-            edict = CEdict(index)
+            edict = get_cached_edict(index)
 
             # Get the weapon's classname
             weapon_class = edict.get_class_name()
@@ -386,8 +386,8 @@ class _PlayerWeapons(_GameWeapons):
 
             # Was a weapon type given and the
             # current weapon is not of that type?
-            if ((is_filters or not_filters) and not weapon_class in list(
-                    WeaponClassIter(is_filters, not_filters, 'classname'))):
+            if ((is_filters or not_filters) and
+                    weapon_class not in classnames):
 
                 # Do not yield this index
                 continue
@@ -435,3 +435,34 @@ class _PlayerWeapons(_GameWeapons):
 
         # Set the entity's color
         BaseEntity(index).color = (red, green, blue, alpha)
+
+
+# =============================================================================
+# >> HELPER FUNCTIONS
+# =============================================================================
+def _get_filter_classnames(is_filters, not_filters):
+    '''Returns the set of classnames of the given weapon types'''
+
+    # Get a hashable key for the filters
+    key = (_filter_key(is_filters), _filter_key(not_filters))
+
+    # Are the classnames not cached yet?
+    if key not in _filter_classnames:
+
+        # Store the classnames of the filters
+        _filter_classnames[key] = frozenset(
+            WeaponClassIter(is_filters, not_filters, 'classname'))
+
+    # Return the classnames
+    return _filter_classnames[key]
+
+
+def _filter_key(filters):
+    '''Returns a hashable version of the given filters'''
+
+    # Is the filter a single string?
+    if isinstance(filters, str):
+        return (filters, )
+
+    # Return the filters as a tuple
+    return tuple(filters)
@@ -0,0 +1,402 @@
+# ../_libs/storage.py
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Python Imports
+#   Queue
+from queue import Queue
+from queue import Empty
+#   Sqlite3
+import sqlite3
+#   Sys
+import sys
+#   Threading
+from threading import Thread
+#   Time
+import time
+
+# Source.Python Imports
+from core import AutoUnload
+from excepthooks import ExceptHooks
+from loggers import _SPLogger
+from public import public
+#   Tick
+from tick_c import get_tick_listener_manager
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Get the CTickListenerManager instance
+TickListenerManager = get_tick_listener_manager()
+
+# Get the sp.storage logger
+StorageLogger = _SPLogger.storage
+
+# Store the GIL switch interval used while a worker is running
+STORAGE_SWITCH_INTERVAL = 0.001
+
+# Store the number of running workers and the original switch interval
+_worker_count = 0
+_default_switch_interval = sys.getswitchinterval()
+
+
+# =============================================================================
+# >> CLASSES
+# =============================================================================
+class _PendingRow(object):
+    '''Stores the coalesced changes of a single key until the next flush'''
+
+    def __init__(self):
+        '''Store the values to set and the values to add'''
+        self.values = dict()
+        self.deltas = dict()
+
+    def set(self, values):
+        '''Overwrite the given columns'''
+
+        # Loop through all given columns
+        for column, value in values.items():
+
+            # A set value replaces all earlier changes of the column
+            self.deltas.pop(column, None)
+            self.values[column] = value
+
+    def add(self, deltas):
+        '''Add to the given columns'''
+
+        # Loop through all given columns
+        for column, delta in deltas.items():
+
+            # Was the column set since the last flush?
+            if column in self.values:
+
+                # Add to the value that will be written
+                self.values[column] += delta
+
+            # Otherwise
+            else:
+
+                # Add to the pending delta
+                self.deltas[column] = self.deltas.get(column, 0) + delta
+
+
+@public
+class PlayerStorage(AutoUnload):
+    '''Sqlite backed storage with one row per key (usually a uniqueid).
+
+        The database is only accessed by a background thread. Changes are
+        coalesced per key and written in a single transaction every
+        flush_interval seconds. Reads are queued behind the pending writes
+        and their callbacks are called on the game thread at the next tick.
+
+        The game thread holds the GIL while the engine runs, so the worker
+        mostly gets it when the plugin releases it at the end of each
+        GameFrame. An idle worker waits on its queue without the GIL and
+        costs nothing there. A busy worker makes the game thread wait until
+        it enters its next sqlite call (which runs without the GIL), at most
+        about STORAGE_SWITCH_INTERVAL seconds per frame. The switch interval
+        is lowered to that value while any worker runs. latency holds the
+        seconds between queueing and completing the last request.
+    '''
+
+    def __init__(self, path, table, columns, flush_interval=1.0):
+        '''Create the table and start the background thread.
+
+            columns is a list of (name, sql_type) tuples.
+        '''
+
+        # Log the init message
+        StorageLogger.log_info(
+            'PlayerStorage.__init__ <{0}> <{1}>'.format(path, table))
+
+        # Store the base attributes
+        self.path = str(path)
+        self.table = table
+        self.columns = [name for name, sql_type in columns]
+        self.flush_interval = flush_interval
+
+        # Store the changes of the current interval
+        self._pending = dict()
+        self._last_flush = time.time()
+
+        # Store the latency of the last request
+        self.latency = 0.0
+
+        # Store the queues between the game thread and the worker
+        self._requests = Queue()
+        self._results = Queue()
+
+        # Create the table from the worker, since it owns the connection
+        self._put_request(self._create_table, (columns, ))
+
+        # Start the worker
+        _start_worker()
+        self._thread = Thread(target=self._work, name='PlayerStorage')
+        self._thread.daemon = True
+        self._thread.start()
+
+        # Register the tick listener
+        TickListenerManager.register_listener(self._tick)
+
+    def set(self, key, **values):
+        '''Overwrite the given columns of the key'''
+        self._get_pending(key).set(values)
+
+    def add(self, key, **deltas):
+        '''Add to the given numeric columns of the key'''
+        self._get_pending(key).add(deltas)
+
+    def get(self, key, callback):
+        '''Call callback(key, row) at a later tick.
+
+            row is a dict of all columns or None if the key isn't stored.
+        '''
+
+        # Make sure the read sees all earlier writes
+        self.flush()
+
+        # Queue the read
+        self._put_request(self._select_row, (key, ), callback)
+
+    def query(self, sql, parameters, callback):
+        '''Execute the given SQL and call callback(rows) at a later tick'''
+
+        # Make sure the query sees all earlier writes
+        self.flush()
+
+        # Queue the query
+        self._put_request(self._select_rows, (sql, parameters), callback)
+
+    def flush(self):
+        '''Hand all pending changes to the worker'''
+
+        # Store the flush time
+        self._last_flush = time.time()
+
+        # Are there any changes?
+        if not self._pending:
+            return
+
+        # Queue the changes as one transaction
+        self._put_request(self._write_rows, (self._pending, ))
+
+        # Start a new interval
+        self._pending = dict()
+
+    def close(self):
+        '''Write all pending changes and stop the worker.
+
+            Blocks until the worker has finished.
+        '''
+
+        # Is the worker already stopped?
+        if self._thread is None:
+            return
+
+        # Log the close message
+        StorageLogger.log_info('PlayerStorage.close <{0}>'.format(self.path))
+
+        # Unregister the tick listener
+        TickListenerManager.unregister_listener(self._tick)
+
+        # Queue the pending changes and stop the worker
+        self.flush()
+        self._requests.put(None)
+        self._thread.join()
+        self._thread = None
+        _stop_worker()
+
+        # Call the remaining callbacks
+        self._tick()
+
+    def _unload_instance(self):
+        '''Close the storage when the addon is unloaded'''
+        self.close()
+
+    def _put_request(self, function, arguments, callback=None):
+        '''Queue a request for the worker'''
+        self._requests.put((function, arguments, callback, time.time()))
+
+    def _get_pending(self, key):
+        '''Return the changes of the key for the current interval'''
+
+        # Is there no entry for the key yet?
+        if key not in self._pending:
+
+            # Add a new entry
+            self._pending[key] = _PendingRow()
+
+        # Return the entry
+        return self._pending[key]
+
+    def _tick(self):
+        '''Flush the changes and call the finished callbacks'''
+
+        # Is it time to write the changes?
+        if time.time() - self._last_flush >= self.flush_interval:
+            self.flush()
+
+        # Loop through all finished requests
+        while True:
+
+            # Get the next result
+            try:
+                callback, result, exc_info = self._results.get_nowait()
+
+            # Are there no more results?
+            except Empty:
+                break
+
+            # Did the request fail?
+            if exc_info is not None:
+
+                # Print the exception to the console
+                ExceptHooks.print_exception(*exc_info)
+                continue
+
+            # Was no callback given?
+            if callback is None:
+                continue
+
+            # Use try/except to continue with the other callbacks on errors
+            try:
+
+                # Call the callback
+                callback(*result)
+
+            # Was an error encountered?
+            except:
+
+                # Print the exception to the console
+                ExceptHooks.print_exception()
+
+    def _work(self):
+        '''Execute all requests in the background thread'''
+
+        # Open the database
+        connection = sqlite3.connect(self.path)
+
+        # Loop until the storage is closed
+        while True:
+
+            # Get the next request
+            request = self._requests.get()
+
+            # Was the storage closed?
+            if request is None:
+                break
+
+            # Get the request's values
+            function, arguments, callback, queued = request
+
+            # Execute the request
+            try:
+                result = function(connection, *arguments)
+
+            # Was an error encountered?
+            except:
+
+                # Hand the exception to the game thread
+                connection.rollback()
+                self._results.put((None, None, sys.exc_info()))
+                continue
+
+            # Store how long the request took
+            finally:
+                self.latency = time.time() - queued
+
+            # Is there any callback to call?
+            if callback is not None:
+
+                # Hand the result to the game thread
+                self._results.put((callback, result, None))
+
+        # Close the database
+        connection.close()
+
+    def _create_table(self, connection, columns):
+        '''Create the table if it doesn't exist'''
+
+        # Create the table
+        with connection:
+            connection.execute(
+                'CREATE TABLE IF NOT EXISTS {0} (key TEXT PRIMARY KEY, '
+                '{1})'.format(self.table, ', '.join(
+                    '{0} {1}'.format(name, sql_type)
+                    for name, sql_type in columns)))
+
+    def _write_rows(self, connection, rows):
+        '''Write all coalesced changes in one transaction'''
+
+        # Use a single transaction
+        with connection:
+
+            # Loop through all changed keys
+            for key, row in rows.items():
+
+                # Make sure the key has a row
+                connection.execute(
+                    'INSERT OR IGNORE INTO {0} (key) VALUES (?)'.format(
+                        self.table), (key, ))
+
+                # Get the assignments of the row. New rows are NULL, so
+                # deltas are added to 0 instead.
+                assignments = ['{0} = ?'.format(column)
+                    for column in row.values]
+                assignments.extend('{0} = COALESCE({0}, 0) + ?'.format(column)
+                    for column in row.deltas)
+
+                # Were all changes of the key empty?
+                if not assignments:
+                    continue
+
+                # Update the row
+                connection.execute(
+                    'UPDATE {0} SET {1} WHERE key = ?'.format(
+                        self.table, ', '.join(assignments)),
+                    list(row.values.values()) +
+                    list(row.deltas.values()) + [key])
+
+    def _select_row(self, connection, key):
+        '''Return the columns of the key'''
+
+        # Get the row
+        row = connection.execute(
+            'SELECT {0} FROM {1} WHERE key = ?'.format(
+                ', '.join(self.columns), self.table), (key, )).fetchone()
+
+        # Return the key and the row as a dictionary
+        return key, None if row is None else dict(zip(self.columns, row))
+
+    def _select_rows(self, connection, sql, parameters):
+        '''Return all rows of the given query'''
+        return (connection.execute(sql, parameters).fetchall(), )
+
+
+# =============================================================================
+# >> FUNCTIONS
+# =============================================================================
+def _start_worker():
+    '''Lower the switch interval when the first worker starts'''
+
+    # Increase the worker count
+    global _worker_count
+    _worker_count += 1
+
+    # Bound the time the game thread waits for a busy worker
+    if _worker_count == 1:
+        sys.setswitchinterval(STORAGE_SWITCH_INTERVAL)
+
+
+def _stop_worker():
+    '''Restore the switch interval when the last worker stopped'''
+
+    # Decrease the worker count
+    global _worker_count
+    _worker_count -= 1
+
+    # Restore the original switch interval
+    if not _worker_count:
+        sys.setswitchinterval(_default_switch_interval)
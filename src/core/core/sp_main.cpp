@@ -31,6 +31,24 @@
 #include "sp_main.h"
 #include "sp_gamedir.h"
 #include "addons/sp_addon.h"
+#include "modules/entities/entities_transmit.h"
+#include "modules/entities/entities_spawn.h"
+#include "modules/entities/entities_lump.h"
+#include "modules/entities/entities_cache.h"
+#include "modules/entities/entities_scheduler.h"
+#include "modules/entities/entities_outputs.h"
+#include "modules/entities/entities_damage.h"
+#include "modules/entities/entities_datastore.h"
+#include "modules/engine/engine_visibility.h"
+#include "modules/players/players_cache.h"
+#include "modules/players/players_weapons.h"
+#include "modules/players/players_usercmd.h"
+#include "modules/players/players_userids.h"
+#include "modules/players/players_snapshot.h"
+#include "modules/players/players_filters.h"
+#include "modules/players/players_netstats.h"
+#include "modules/players/players_convars.h"
+#include "utility/sp_util.h"
 #include "interface.h"
 #include "filesystem.h"
 #include "eiface.h"
@@ -77,8 +95,11 @@ CGlobalVars*			gpGlobals			= NULL;
 IFileSystem*			filesystem			= NULL;
 IEffects*				effects				= NULL;
 IServerGameDLL*			servergamedll		= NULL;
+IServerGameEnts*		gameents			= NULL;
+IServerGameClients*		servergameclients	= NULL;
 IServerTools*			servertools			= NULL;
 INetworkStringTableContainer* networkstringtable = NULL;
+CSharedEdictChangeInfo*	g_pSharedChangeInfo	= NULL;
 
 //---------------------------------------------------------------------------------
 // External globals
@@ -134,6 +155,8 @@ InterfaceHelper_t gGameInterfaces[] = {
 	{INTERFACEVERSION_PLAYERBOTMANAGER, (void **)&botmanager},
 	{IEFFECTS_INTERFACE_VERSION, (void **)&effects},
 	{INTERFACEVERSION_SERVERGAMEDLL, (void **)&servergamedll},
+	{INTERFACEVERSION_SERVERGAMEENTS, (void **)&gameents},
+	{INTERFACEVERSION_SERVERGAMECLIENTS, (void **)&servergameclients},
 #if( SOURCE_ENGINE >= 2 )
 	{VSERVERTOOLS_INTERFACE_VERSION, (void **)&servertools},
 #endif
@@ -203,7 +226,16 @@ bool CSourcePython::Load(	CreateInterfaceFn interfaceFactory, CreateInterfaceFn
 		return false;
 	}
 
+#if( SOURCE_ENGINE < 2 )
+	// Not every game of this engine provides IServerTools, so it's optional.
+	servertools = (IServerTools *) gameServerFactory(VSERVERTOOLS_INTERFACE_VERSION, NULL);
+#endif
+
 	gpGlobals = playerinfomanager->GetGlobalVars();
+	g_pSharedChangeInfo = engine->GetSharedEdictChangeInfo();
+
+	// The plugin might be loaded while clients are on the server.
+	g_UserIDTable.rebuild();
 
 	MathLib_Init( 2.2f, 2.2f, 0.0f, 2.0f );
 	InitCommands();
@@ -232,8 +264,25 @@ void CSourcePython::Unload( void )
 	ClearAllCommands();
 	ConVar_Unregister( );
 
+	// Release all cached Python objects while Python is still running.
+	get_entity_spawn_queue()->clear();
+	get_entity_scheduler()->clear();
+	get_output_listener_manager()->clear();
+	get_damage_manager()->clear();
+	get_usercmd_manager()->clear();
+	get_net_channel_sampler()->clear();
+	g_ClientConVarCache.clear();
+	g_PlayerSnapshot.clear();
+	release_data_store_views();
+	get_map_entity_lump()->clear();
+	g_EdictCache.clear();
+	g_PlayerInfoCache.clear();
+
 	g_PythonManager.Shutdown();
 
+	// Scripts could reference the stores until Python shut down.
+	clear_data_stores();
+
 	// New in CSGO...
 #if( SOURCE_ENGINE >= 3 )
 	DisconnectInterfaces();
@@ -270,7 +319,8 @@ const char *CSourcePython::GetPluginDescription( void )
 //---------------------------------------------------------------------------------
 void CSourcePython::LevelInit( char const *pMapName )
 {
-
+	get_map_entity_lump()->parse(engine->GetMapEntitiesString());
+	get_visibility_cache()->build();
 }
 
 //---------------------------------------------------------------------------------
@@ -286,7 +336,17 @@ void CSourcePython::ServerActivate( edict_t *pEdictList, int edictCount, int cli
 //---------------------------------------------------------------------------------
 void CSourcePython::GameFrame( bool simulating )
 {
+	get_visibility_cache()->process();
 	g_AddonManager.GameFrame();
+	get_entity_spawn_queue()->process();
+	get_entity_scheduler()->process();
+	get_output_listener_manager()->process();
+	get_usercmd_manager()->process();
+	get_net_channel_sampler()->process();
+	g_ClientConVarCache.process();
+
+	// Let Python threads (e.g. storage workers) run outside of any callback.
+	g_PythonManager.AllowThreads();
 }
 
 //---------------------------------------------------------------------------------
@@ -294,6 +354,16 @@ void CSourcePython::GameFrame( bool simulating )
 //---------------------------------------------------------------------------------
 void CSourcePython::LevelShutdown( void ) // !!!!this can get called multiple times per map change
 {
+	get_transmit_manager()->clear_all_rules();
+	get_entity_spawn_queue()->clear();
+	get_entity_scheduler()->clear();
+	get_output_listener_manager()->clear_events();
+	get_visibility_cache()->clear();
+	get_weapon_inventory()->clear();
+	get_usercmd_manager()->clear_batch();
+	reset_edict_stores();
+	g_EdictCache.clear();
+	g_PlayerInfoCache.clear();
 }
 
 //---------------------------------------------------------------------------------
@@ -308,6 +378,16 @@ void CSourcePython::ClientActive( edict_t *pEntity )
 //---------------------------------------------------------------------------------
 void CSourcePython::ClientDisconnect( edict_t *pEntity )
 {
+	int iIndex = IndexOfEdict(pEntity);
+	get_transmit_manager()->clear_player(iIndex);
+	g_PlayerInfoCache.invalidate(iIndex);
+	get_weapon_inventory()->invalidate(iIndex);
+	get_usercmd_manager()->clear_player(iIndex);
+	get_net_channel_sampler()->clear_player(iIndex);
+	reset_player_data(iIndex);
+	g_ClientConVarCache.clear_player(iIndex);
+	g_UserIDTable.remove_player(iIndex);
+	g_PlayerFilterMasks.invalidate();
 }
 
 //---------------------------------------------------------------------------------
@@ -315,6 +395,9 @@ void CSourcePython::ClientDisconnect( edict_t *pEntity )
 //---------------------------------------------------------------------------------
 void CSourcePython::ClientPutInServer( edict_t *pEntity, char const *playername )
 {
+	g_UserIDTable.add_player(pEntity);
+	g_PlayerInfoCache.update(pEntity);
+	g_PlayerFilterMasks.invalidate();
 }
 
 //---------------------------------------------------------------------------------
@@ -341,7 +424,7 @@ void ClientPrint( edict_t *pEdict, char *format, ... )
 //---------------------------------------------------------------------------------
 void CSourcePython::ClientSettingsChanged( edict_t *pEdict )
 {
-
+	g_ClientConVarCache.invalidate(IndexOfEdict(pEdict));
 }
 
 //---------------------------------------------------------------------------------
@@ -357,6 +440,7 @@ PLUGIN_RESULT CSourcePython::ClientConnect( bool *bAllowConnect, edict_t *pEntit
 //---------------------------------------------------------------------------------
 PLUGIN_RESULT CSourcePython::NetworkIDValidated( const char *pszUserName, const char *pszNetworkID )
 {
+	g_UserIDTable.update_networkid(pszNetworkID);
 	return PLUGIN_CONTINUE;
 }
 
@@ -367,6 +451,7 @@ void CSourcePython::OnQueryCvarValueFinished( QueryCvarCookie_t iCookie, edict_t
 	EQueryCvarValueStatus eStatus, const char *pCvarName, const char *pCvarValue )
 {
 	DevMsg(0, "Cvar query (cookie: %d, status: %d) - name: %s, value: %s\n", iCookie, eStatus, pCvarName, pCvarValue );
+	g_ClientConVarCache.on_query_finished(iCookie, eStatus, pCvarValue);
 }
 
 //---------------------------------------------------------------------------------
@@ -412,6 +497,10 @@ void CSourcePython::OnEdictAllocated( edict_t *edict )
 
 void CSourcePython::OnEdictFreed( const edict_t *edict )
 {
-
+	int iIndex = IndexOfEdict(edict);
+	g_EdictCache.invalidate(iIndex);
+	g_PlayerInfoCache.invalidate(iIndex);
+	get_entity_scheduler()->cancel_all(iIndex);
+	reset_edict_data(iIndex);
 }
 #endif
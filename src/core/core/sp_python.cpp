@@ -136,3 +136,17 @@ bool CPythonManager::Shutdown( void )
 {
 	return true;
 }
+
+//---------------------------------------------------------------------------------
+// The game thread holds the GIL all the time, even while the engine runs, so
+// Python threads would only get it by interrupting a callback. Releasing it
+// once per frame hands it to a thread that has been waiting for a switch
+// interval. Without waiting threads this costs nothing. Otherwise the game
+// thread blocks until that thread releases the GIL again, i.e. when it blocks
+// on I/O or after another switch interval (see sys.setswitchinterval).
+//---------------------------------------------------------------------------------
+void CPythonManager::AllowThreads( void )
+{
+	Py_BEGIN_ALLOW_THREADS
+	Py_END_ALLOW_THREADS
+}
@@ -50,6 +50,9 @@ class CPythonManager
 		bool Initialize( void );
 		bool Shutdown( void );
 
+		// Releases the GIL for a moment, so Python threads can run.
+		void AllowThreads( void );
+
 		// Returns the dict for sp.py.
 		python::object GetSP( void ) { return m_SpPy; }
 };
@@ -43,6 +43,7 @@
 #include "client_textmessage.h"
 #include "steam/steamclientpublic.h"
 #include "eiface_wrap.h"
+#include "engine_visibility.h"
 
 //---------------------------------------------------------------------------------
 // Namespaces to use
@@ -66,6 +67,7 @@ CEngineServer* get_engine_interface()
 // Exposer functions.
 //---------------------------------------------------------------------------------
 void export_engine_interface();
+void export_visibility_cache();
 
 //---------------------------------------------------------------------------------
 // Method overloads
@@ -81,6 +83,7 @@ DECLARE_CLASS_METHOD_OVERLOAD(CEngineServer, precache_generic,			1, 2);
 DECLARE_SP_MODULE(engine_c)
 {
 	export_engine_interface();
+	export_visibility_cache();
 }
 
 //---------------------------------------------------------------------------------
@@ -807,3 +810,63 @@ void export_engine_interface()
 
 	BOOST_END_CLASS()
 }
+
+//---------------------------------------------------------------------------------
+// Exposes CVisibilityCache.
+//---------------------------------------------------------------------------------
+void export_visibility_cache()
+{
+	BOOST_ABSTRACT_CLASS(CVisibilityCache)
+
+		CLASS_METHOD(CVisibilityCache,
+			get_cluster_count,
+			"Returns the number of clusters of the map."
+		)
+
+		CLASS_METHOD(CVisibilityCache,
+			get_cluster,
+			"Returns the cluster of the given origin.",
+			args("origin")
+		)
+
+		CLASS_METHOD(CVisibilityCache,
+			is_cluster_visible,
+			"Returns True if to_cluster is in the cached PVS of from_cluster.",
+			args("from_cluster", "to_cluster")
+		)
+
+		CLASS_METHOD(CVisibilityCache,
+			is_origin_visible,
+			"Returns True if the cluster of end is in the cached PVS of the cluster of start.",
+			args("start", "end")
+		)
+
+		CLASS_METHOD(CVisibilityCache,
+			can_see,
+			"Returns True if player_b is potentially visible to player_a this tick.",
+			args("player_a", "player_b")
+		)
+
+		CLASS_METHOD(CVisibilityCache,
+			get_player_matrix,
+			"Returns a read-only memoryview of the players x players visibility matrix. Row i holds one bit per player index (least significant bit first) and is refreshed every tick."
+		)
+
+		CLASS_METHOD(CVisibilityCache,
+			get_row_size,
+			"Returns the size of a row of the player matrix in bytes."
+		)
+
+		CLASS_METHOD(CVisibilityCache,
+			get_entity_matrix,
+			"Returns the players x entities visibility matrix of the given entity indexes as bytes. Each row has (len(indexes) + 7) // 8 bytes.",
+			args("indexes")
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_visibility_cache,
+		"Returns the CVisibilityCache instance",
+		reference_existing_object_policy()
+	);
+}
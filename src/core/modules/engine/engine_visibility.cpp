@@ -0,0 +1,260 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "engine_visibility.h"
+#include "eiface.h"
+#include "engine/ICollideable.h"
+#include "game/server/iplayerinfo.h"
+#include "utility/sp_util.h"
+
+//---------------------------------------------------------------------------------
+// External variables.
+//---------------------------------------------------------------------------------
+extern IVEngineServer* engine;
+extern IServerGameClients* servergameclients;
+extern CGlobalVars* gpGlobals;
+
+//---------------------------------------------------------------------------------
+// Static singletons.
+//---------------------------------------------------------------------------------
+static CVisibilityCache s_VisibilityCache;
+
+//---------------------------------------------------------------------------------
+// VisibilityCache accessor.
+//---------------------------------------------------------------------------------
+CVisibilityCache* get_visibility_cache()
+{
+	return &s_VisibilityCache;
+}
+
+//---------------------------------------------------------------------------------
+// CVisibilityCache code.
+//---------------------------------------------------------------------------------
+CVisibilityCache::CVisibilityCache()
+{
+	m_iClusterCount = 0;
+	m_iPVSSize = 0;
+	m_bMatrixEnabled = false;
+	m_iMatrixTick = -1;
+}
+
+void CVisibilityCache::build()
+{
+	clear();
+
+	int iClusterCount = engine->GetClusterCount();
+	if( iClusterCount <= 0 )
+		return;
+
+	m_iClusterCount = iClusterCount;
+	m_iPVSSize = (iClusterCount + 7) / 8;
+	m_ClusterPVS.assign(m_iClusterCount * m_iPVSSize, 0);
+
+	for( int i = 0; i < m_iClusterCount; i++ )
+	{
+		engine->GetPVSForCluster(i, m_iPVSSize, &m_ClusterPVS[i * m_iPVSSize]);
+	}
+}
+
+void CVisibilityCache::clear()
+{
+	m_iClusterCount = 0;
+	m_iPVSSize = 0;
+	m_ClusterPVS.clear();
+
+	// Views of the matrix stay valid, so it keeps being updated on the next map.
+	m_iMatrixTick = -1;
+	for( int i = 0; i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+	{
+		m_PlayerClusters[i] = -1;
+		m_PlayerMatrix[i].ClearAll();
+	}
+}
+
+bool CVisibilityCache::ensure_built()
+{
+	// The plugin may have been loaded after the level started.
+	if( !m_iClusterCount )
+		build();
+
+	return m_iClusterCount > 0;
+}
+
+int CVisibilityCache::get_cluster_count()
+{
+	ensure_built();
+	return m_iClusterCount;
+}
+
+int CVisibilityCache::get_cluster( const CVector& origin )
+{
+	return engine->GetClusterForOrigin(origin);
+}
+
+bool CVisibilityCache::is_cluster_visible( int from_cluster, int to_cluster )
+{
+	if( !ensure_built() )
+		return false;
+
+	if( from_cluster < 0 || from_cluster >= m_iClusterCount || to_cluster < 0 || to_cluster >= m_iClusterCount )
+		return false;
+
+	return (m_ClusterPVS[from_cluster * m_iPVSSize + (to_cluster >> 3)] & (1 << (to_cluster & 7))) != 0;
+}
+
+bool CVisibilityCache::is_origin_visible( const CVector& start, const CVector& end )
+{
+	return is_cluster_visible(get_cluster(start), get_cluster(end));
+}
+
+bool CVisibilityCache::can_see( int player_a, int player_b )
+{
+	if( player_a <= 0 || player_a > ABSOLUTE_PLAYER_LIMIT || player_b <= 0 || player_b > ABSOLUTE_PLAYER_LIMIT )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index.")
+
+	m_bMatrixEnabled = true;
+	update_player_matrix();
+	return m_PlayerMatrix[player_a].IsBitSet(player_b);
+}
+
+object CVisibilityCache::get_player_matrix()
+{
+	m_bMatrixEnabled = true;
+	update_player_matrix();
+
+	PyObject* pView = PyMemoryView_FromMemory((char *) m_PlayerMatrix, sizeof(m_PlayerMatrix), PyBUF_READ);
+	return object(handle<>(pView));
+}
+
+int CVisibilityCache::get_row_size()
+{
+	return sizeof(CVisibilityPlayerBits);
+}
+
+object CVisibilityCache::get_entity_matrix( object indexes )
+{
+	m_bMatrixEnabled = true;
+	update_player_matrix();
+
+	int iCount = len(indexes);
+	int iRowSize = (iCount + 7) / 8;
+	int iRows = gpGlobals->maxClients + 1;
+
+	// Look up the cluster of every entity once.
+	std::vector<int> clusters(iCount, -1);
+	for( int i = 0; i < iCount; i++ )
+	{
+		edict_t* pEdict = PEntityOfEntIndex(extract<int>(indexes[i]));
+		if( !pEdict || pEdict->IsFree() || !pEdict->GetUnknown() )
+			continue;
+
+		ICollideable* pCollideable = pEdict->GetUnknown()->GetCollideable();
+		if( pCollideable )
+			clusters[i] = get_cluster(pCollideable->GetCollisionOrigin());
+	}
+
+	std::vector<char> matrix(iRows * iRowSize, 0);
+	for( int iPlayer = 1; iPlayer < iRows; iPlayer++ )
+	{
+		int iFrom = m_PlayerClusters[iPlayer];
+		if( iFrom < 0 )
+			continue;
+
+		char* pRow = &matrix[iPlayer * iRowSize];
+		for( int i = 0; i < iCount; i++ )
+		{
+			if( is_cluster_visible(iFrom, clusters[i]) )
+				pRow[i >> 3] |= (1 << (i & 7));
+		}
+	}
+
+	PyObject* pBytes = PyBytes_FromStringAndSize(matrix.empty() ? NULL : &matrix[0], matrix.size());
+	return object(handle<>(pBytes));
+}
+
+void CVisibilityCache::process()
+{
+	// Keep shared views of the matrix up to date.
+	if( m_bMatrixEnabled )
+		update_player_matrix();
+}
+
+void CVisibilityCache::update_player_clusters()
+{
+	for( int i = 1; i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+	{
+		m_PlayerClusters[i] = -1;
+		if( i > gpGlobals->maxClients )
+			continue;
+
+		edict_t* pEdict = PEntityOfEntIndex(i);
+		if( !pEdict || pEdict->IsFree() )
+			continue;
+
+		IPlayerInfo* pPlayerInfo = PlayerOfIndex(i);
+		if( !pPlayerInfo || !pPlayerInfo->IsConnected() )
+			continue;
+
+		// The PVS is looked up from the player's eyes.
+		Vector vecEyes;
+		servergameclients->ClientEarPosition(pEdict, &vecEyes);
+		m_PlayerClusters[i] = engine->GetClusterForOrigin(vecEyes);
+	}
+}
+
+void CVisibilityCache::update_player_matrix()
+{
+	if( m_iMatrixTick == gpGlobals->tickcount )
+		return;
+
+	m_iMatrixTick = gpGlobals->tickcount;
+	for( int i = 0; i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+	{
+		m_PlayerMatrix[i].ClearAll();
+	}
+
+	if( !ensure_built() )
+		return;
+
+	update_player_clusters();
+
+	int iMaxClients = gpGlobals->maxClients;
+	for( int a = 1; a <= iMaxClients; a++ )
+	{
+		int iFrom = m_PlayerClusters[a];
+		if( iFrom < 0 )
+			continue;
+
+		for( int b = 1; b <= iMaxClients; b++ )
+		{
+			if( is_cluster_visible(iFrom, m_PlayerClusters[b]) )
+				m_PlayerMatrix[a].Set(b);
+		}
+	}
+}
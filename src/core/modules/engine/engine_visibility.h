@@ -0,0 +1,97 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _ENGINE_VISIBILITY_H
+#define _ENGINE_VISIBILITY_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <vector>
+#include "const.h"
+#include "bitvec.h"
+#include "utility/wrap_macros.h"
+#include "modules/vecmath/vecmath_wrap.h"
+
+//---------------------------------------------------------------------------------
+// Player slot bits. Slot 0 is unused, so player indexes can be used directly.
+//---------------------------------------------------------------------------------
+typedef CBitVec<ABSOLUTE_PLAYER_LIMIT + 1> CVisibilityPlayerBits;
+
+//---------------------------------------------------------------------------------
+// Caches the PVS of every cluster of the map when the level starts and
+// computes a players x players potential visibility matrix once per tick.
+// The matrix is exposed as a read-only buffer, so all addons share one
+// computation. Row i holds the players that are potentially visible to
+// player i, one bit per player index (least significant bit first).
+//---------------------------------------------------------------------------------
+class CVisibilityCache
+{
+public:
+	CVisibilityCache();
+
+	// Reads the PVS of all clusters. Called when the level starts.
+	void	build();
+	void	clear();
+
+	int		get_cluster_count();
+	int		get_cluster( const CVector& origin );
+	bool	is_cluster_visible( int from_cluster, int to_cluster );
+	bool	is_origin_visible( const CVector& start, const CVector& end );
+
+	// Returns True if player_b is potentially visible to player_a this tick.
+	bool	can_see( int player_a, int player_b );
+
+	// Returns a read-only memoryview of the player matrix. It's refreshed
+	// every tick once it was requested.
+	object	get_player_matrix();
+	int		get_row_size();
+
+	// Returns the players x entities matrix of the given entity indexes as
+	// bytes. Each row has (len(indexes) + 7) // 8 bytes.
+	object	get_entity_matrix( object indexes );
+
+	// Called once per frame.
+	void	process();
+
+private:
+	bool	ensure_built();
+	void	update_player_matrix();
+	void	update_player_clusters();
+
+private:
+	int								m_iClusterCount;
+	int								m_iPVSSize;
+	std::vector<unsigned char>		m_ClusterPVS;
+
+	bool							m_bMatrixEnabled;
+	int								m_iMatrixTick;
+	int								m_PlayerClusters[ABSOLUTE_PLAYER_LIMIT + 1];
+	CVisibilityPlayerBits			m_PlayerMatrix[ABSOLUTE_PLAYER_LIMIT + 1];
+};
+
+CVisibilityCache* get_visibility_cache();
+
+#endif // _ENGINE_VISIBILITY_H
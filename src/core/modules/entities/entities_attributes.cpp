@@ -0,0 +1,299 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "entities_attributes.h"
+#include "entities_wrap.h"
+#include "entities_props.h"
+#include "entities_datamaps.h"
+#include "dt_common.h"
+#include "string_t.h"
+
+//---------------------------------------------------------------------------------
+// CEntityAttribute code.
+//---------------------------------------------------------------------------------
+CEntityAttribute::CEntityAttribute( const char* name, EntityAttributeSource source, const char* type_name )
+{
+	m_name = name;
+	m_source = source;
+	m_has_bool_values = false;
+	m_true_value = 1;
+	m_false_value = 0;
+
+	// Resolve the type name once, so accessing the attribute doesn't have to.
+	if( V_stricmp(type_name, "int") == 0 )
+		m_type = TYPE_INT;
+	else if( V_stricmp(type_name, "float") == 0 )
+		m_type = TYPE_FLOAT;
+	else if( V_stricmp(type_name, "string") == 0 )
+		m_type = TYPE_STRING;
+	else if( V_stricmp(type_name, "vector") == 0 )
+		m_type = TYPE_VECTOR;
+	else
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Invalid attribute type.")
+}
+
+void CEntityAttribute::set_bool_values( int true_value, int false_value )
+{
+	m_has_bool_values = true;
+	m_true_value = true_value;
+	m_false_value = false_value;
+}
+
+const char* CEntityAttribute::get_name()
+{
+	return m_name.c_str();
+}
+
+bool CEntityAttribute::is_compatible( fieldtype_t type, int count )
+{
+	switch( m_type )
+	{
+		case TYPE_INT:
+			switch( type )
+			{
+				case FIELD_INTEGER:
+				case FIELD_TICK:
+				case FIELD_MODELINDEX:
+				case FIELD_MATERIALINDEX:
+				case FIELD_COLOR32:
+				case FIELD_EHANDLE:
+				case FIELD_SHORT:
+				case FIELD_BOOLEAN:
+					return true;
+
+				case FIELD_CHARACTER:
+					return count == 1;
+			}
+			return false;
+
+		case TYPE_FLOAT:
+			return type == FIELD_FLOAT || type == FIELD_TIME;
+
+		case TYPE_STRING:
+			return type == FIELD_STRING || type == FIELD_MODELNAME || type == FIELD_SOUNDNAME || type == FIELD_CHARACTER;
+
+		case TYPE_VECTOR:
+			return type == FIELD_VECTOR || type == FIELD_POSITION_VECTOR;
+	}
+
+	return false;
+}
+
+const CEntityAttribute::ResolvedField_t* CEntityAttribute::resolve( edict_t* pEdict, void* pEntity )
+{
+	// The vtable identifies the entity's C++ class, which determines both
+	// the send table and the datamap.
+	void* pVTable = *(void **) pEntity;
+	boost::unordered_map<void*, ResolvedField_t>::iterator it = m_fields.find(pVTable);
+	if( it != m_fields.end() )
+		return &it->second;
+
+	ResolvedField_t field;
+	field.offset = -1;
+	field.type = FIELD_VOID;
+	field.count = 0;
+	field.networked = false;
+
+	if( m_source == ATTRIBUTE_SENDPROP )
+	{
+		int iOffset = 0;
+		SendProp* pProp = UTIL_GetSendProp(pEdict, m_name.c_str(), iOffset);
+		if( pProp )
+		{
+			// Describe the send prop like a datamap field.
+			field.count = 1;
+			switch( pProp->GetType() )
+			{
+				case DPT_Int:		field.type = FIELD_INTEGER; break;
+				case DPT_Float:		field.type = FIELD_FLOAT; break;
+				case DPT_Vector:	field.type = FIELD_VECTOR; break;
+				case DPT_String:
+					field.type = FIELD_CHARACTER;
+					field.count = DT_MAX_STRING_BUFFERSIZE;
+					break;
+			}
+
+			if( field.type != FIELD_VOID )
+			{
+				field.offset = iOffset;
+				field.networked = true;
+			}
+		}
+	}
+	else
+	{
+		CDataMapTable* pTable = UTIL_GetDataMapTable(pEdict);
+		const CDataMapOffset* pOffset = pTable ? pTable->get_offset(m_name.c_str()) : NULL;
+		if( pOffset )
+		{
+			field.type = pOffset->type;
+			field.count = pOffset->count;
+			field.offset = pOffset->offset;
+
+			// Datamap fields are only networked if a send prop shares their offset.
+			ServerClass* pServerClass = pEdict->GetNetworkable()->GetServerClass();
+			field.networked = pServerClass && UTIL_IsSendPropOffset(pServerClass->m_pTable, field.offset);
+		}
+	}
+
+	// Reading a field with the wrong type would reinterpret its bits.
+	if( field.offset != -1 && !is_compatible(field.type, field.count) )
+	{
+		PyErr_Format(PyExc_TypeError, "Attribute \"%s\" of \"%s\" doesn't match the declared type.",
+			m_name.c_str(), pEdict->GetClassName());
+		throw_error_already_set();
+	}
+
+	return &(m_fields[pVTable] = field);
+}
+
+char* CEntityAttribute::get_address( object instance, edict_t*& pEdict, const ResolvedField_t*& pField )
+{
+	// Look the edict up with an interned name, so no string is built per access.
+	static PyObject* s_pEdictName = PyUnicode_InternFromString("edict");
+	object edict(handle<>(PyObject_GetAttr(instance.ptr(), s_pEdictName)));
+
+	CEdict* pWrapper = extract<CEdict*>(edict);
+	pEdict = pWrapper->get_edict();
+	if( !pEdict || pEdict->IsFree() || !pEdict->GetUnknown() )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Entity is not valid.")
+
+	char* pEntity = (char *) pEdict->GetUnknown()->GetBaseEntity();
+	pField = resolve(pEdict, pEntity);
+	if( pField->offset == -1 )
+	{
+		PyErr_Format(PyExc_AttributeError, "Attribute \"%s\" not found", m_name.c_str());
+		throw_error_already_set();
+	}
+
+	return pEntity + pField->offset;
+}
+
+object CEntityAttribute::__get__( object self, object instance, object owner )
+{
+	// Accessed through the class.
+	if( instance.is_none() )
+		return self;
+
+	CEntityAttribute& attribute = extract<CEntityAttribute&>(self);
+
+	edict_t* pEdict;
+	const ResolvedField_t* pField;
+	char* pData = attribute.get_address(instance, pEdict, pField);
+
+	switch( attribute.m_type )
+	{
+		case TYPE_INT:
+		{
+			int iValue;
+			switch( pField->type )
+			{
+				case FIELD_SHORT:		iValue = *(short *) pData; break;
+				case FIELD_BOOLEAN:		iValue = *(bool *) pData; break;
+				case FIELD_CHARACTER:	iValue = *(char *) pData; break;
+				default:				iValue = *(int *) pData; break;
+			}
+
+			if( attribute.m_has_bool_values )
+				return object(iValue == attribute.m_true_value);
+
+			return object(iValue);
+		}
+
+		case TYPE_FLOAT:
+			return object(*(float *) pData);
+
+		case TYPE_STRING:
+		{
+			if( pField->type == FIELD_CHARACTER )
+				return object((const char *) pData);
+
+			return object(STRING(*(string_t *) pData));
+		}
+
+		case TYPE_VECTOR:
+			return object(CVector(*(Vector *) pData));
+	}
+
+	return object();
+}
+
+void CEntityAttribute::__set__( object instance, object value )
+{
+	edict_t* pEdict;
+	const ResolvedField_t* pField;
+	char* pData = get_address(instance, pEdict, pField);
+
+	switch( m_type )
+	{
+		case TYPE_INT:
+		{
+			int iValue;
+			if( m_has_bool_values )
+				iValue = extract<bool>(value) ? m_true_value : m_false_value;
+			else
+				iValue = extract<int>(value);
+
+			switch( pField->type )
+			{
+				case FIELD_SHORT:		*(short *) pData = (short) iValue; break;
+				case FIELD_BOOLEAN:		*(bool *) pData = (iValue != 0); break;
+				case FIELD_CHARACTER:	*(char *) pData = (char) iValue; break;
+				default:				*(int *) pData = iValue; break;
+			}
+			break;
+		}
+
+		case TYPE_FLOAT:
+			*(float *) pData = extract<float>(value);
+			break;
+
+		case TYPE_STRING:
+		{
+			// We can't write into the game's string pool.
+			if( pField->type != FIELD_CHARACTER )
+				BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Attribute is not a writable string.")
+
+			const char* szValue = extract<const char*>(value);
+			V_strncpy(pData, szValue, pField->count);
+			break;
+		}
+
+		case TYPE_VECTOR:
+		{
+			CVector& vec = extract<CVector&>(value);
+			*(Vector *) pData = vec;
+			break;
+		}
+	}
+
+	// Server-only fields don't need a network update.
+	if( pField->networked )
+		pEdict->StateChanged(pField->offset);
+}
@@ -0,0 +1,106 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _ENTITIES_ATTRIBUTES_H
+#define _ENTITIES_ATTRIBUTES_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <string>
+#include "boost/unordered_map.hpp"
+#include "edict.h"
+#include "datamap.h"
+#include "utility/wrap_macros.h"
+
+//---------------------------------------------------------------------------------
+// Where the value of an entity attribute is stored.
+//---------------------------------------------------------------------------------
+enum EntityAttributeSource
+{
+	ATTRIBUTE_SENDPROP,
+	ATTRIBUTE_DATAMAP
+};
+
+//---------------------------------------------------------------------------------
+// Python descriptor for a single send prop or datamap field. Entity classes get
+// one instance per attribute, so reading player.health is a single native call.
+// The offset is resolved once per entity class (keyed by the entity's vtable)
+// and the field's type is checked against the declared type at that time.
+//---------------------------------------------------------------------------------
+class CEntityAttribute
+{
+public:
+	CEntityAttribute( const char* name, EntityAttributeSource source, const char* type_name );
+
+	// Maps the attribute to True/False (used for properties like noclip).
+	void			set_bool_values( int true_value, int false_value );
+
+	const char*		get_name();
+
+	// Descriptor protocol. The instance needs an "edict" attribute (CEdict).
+	static object	__get__( object self, object instance, object owner );
+	void			__set__( object instance, object value );
+
+private:
+	enum AttributeType
+	{
+		TYPE_INT,
+		TYPE_FLOAT,
+		TYPE_STRING,
+		TYPE_VECTOR
+	};
+
+	// The resolved field of a single entity class.
+	struct ResolvedField_t
+	{
+		int				offset;
+		fieldtype_t		type;
+		int				count;
+
+		// Whether the value is sent to clients.
+		bool			networked;
+	};
+
+	// Returns the address of the value. Raises if it can't be resolved.
+	char*			get_address( object instance, edict_t*& pEdict, const ResolvedField_t*& pField );
+	const ResolvedField_t* resolve( edict_t* pEdict, void* pEntity );
+	bool			is_compatible( fieldtype_t type, int count );
+
+private:
+	std::string				m_name;
+	EntityAttributeSource	m_source;
+	AttributeType			m_type;
+
+	bool					m_has_bool_values;
+	int						m_true_value;
+	int						m_false_value;
+
+	// Resolved fields by the vtable of the entity class. Classes that don't
+	// have the field are stored with an offset of -1.
+	boost::unordered_map<void*, ResolvedField_t>	m_fields;
+};
+
+#endif // _ENTITIES_ATTRIBUTES_H
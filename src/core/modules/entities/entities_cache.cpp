@@ -0,0 +1,102 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "entities_cache.h"
+#include "entities_wrap.h"
+#include "utility/sp_util.h"
+
+//---------------------------------------------------------------------------------
+// Global accessor.
+//---------------------------------------------------------------------------------
+CEdictCache g_EdictCache;
+
+//---------------------------------------------------------------------------------
+// Exposed functions.
+//---------------------------------------------------------------------------------
+object get_cached_edict( int index )
+{
+	return g_EdictCache.get_edict(index);
+}
+
+//---------------------------------------------------------------------------------
+// CEdictCache code.
+//---------------------------------------------------------------------------------
+CEdictCache::CEdictCache()
+{
+	for( int i = 0; i < MAX_EDICTS; i++ )
+	{
+		m_Entries[i].iSerialNumber = -1;
+	}
+}
+
+object CEdictCache::get_edict( int index )
+{
+	if( index < 0 || index >= MAX_EDICTS )
+		return object();
+
+	return get_edict(PEntityOfEntIndex(index));
+}
+
+object CEdictCache::get_edict( edict_t* pEdict )
+{
+	if( !pEdict || pEdict->IsFree() )
+		return object();
+
+	int index = IndexOfEdict(pEdict);
+	if( index < 0 || index >= MAX_EDICTS )
+		return object();
+
+	CacheEntry_t& entry = m_Entries[index];
+	if( entry.iSerialNumber != pEdict->m_NetworkSerialNumber || entry.edict.is_none() )
+	{
+		// The Python object owns the new wrapper.
+		manage_new_object::apply<CEdict *>::type convert;
+		entry.edict = object(handle<>(convert(new CEdict(pEdict))));
+		entry.iSerialNumber = pEdict->m_NetworkSerialNumber;
+	}
+
+	return entry.edict;
+}
+
+void CEdictCache::invalidate( int index )
+{
+	if( index < 0 || index >= MAX_EDICTS )
+		return;
+
+	m_Entries[index].iSerialNumber = -1;
+	m_Entries[index].edict = object();
+}
+
+void CEdictCache::clear()
+{
+	for( int i = 0; i < MAX_EDICTS; i++ )
+	{
+		invalidate(i);
+	}
+}
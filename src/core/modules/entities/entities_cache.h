@@ -0,0 +1,73 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _ENTITIES_CACHE_H
+#define _ENTITIES_CACHE_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "edict.h"
+#include "utility/wrap_macros.h"
+
+//---------------------------------------------------------------------------------
+// Keeps one Python CEdict object per edict slot. The object is validated by the
+// edict's serial number, so a reused slot gets a new object. Returning the same
+// object everywhere makes CEdict instances usable as cheap dict keys.
+//---------------------------------------------------------------------------------
+class CEdictCache
+{
+public:
+	CEdictCache();
+
+	// Returns the CEdict instance of the slot or None if the edict is free.
+	object	get_edict( int index );
+	object	get_edict( edict_t* pEdict );
+
+	// Drops the cached object of the slot.
+	void	invalidate( int index );
+	void	clear();
+
+private:
+	struct CacheEntry_t
+	{
+		int		iSerialNumber;
+		object	edict;
+	};
+
+	CacheEntry_t	m_Entries[MAX_EDICTS];
+};
+
+//---------------------------------------------------------------------------------
+// Global accessor.
+//---------------------------------------------------------------------------------
+extern CEdictCache g_EdictCache;
+
+//---------------------------------------------------------------------------------
+// Exposed functions.
+//---------------------------------------------------------------------------------
+object get_cached_edict( int index );
+
+#endif // _ENTITIES_CACHE_H
@@ -0,0 +1,408 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <algorithm>
+#include "entities_damage.h"
+#include "entities_datamaps.h"
+#include "game/server/iplayerinfo.h"
+#include "cpp_manager.h"
+#include "modules/memory/memory_hooks.h"
+#include "utility/sp_team.h"
+#include "utility/sp_util.h"
+
+//---------------------------------------------------------------------------------
+// External variables.
+//---------------------------------------------------------------------------------
+extern CGlobalVars* gpGlobals;
+
+//---------------------------------------------------------------------------------
+// Static singletons.
+//---------------------------------------------------------------------------------
+static CDamageManager s_DamageManager;
+
+//---------------------------------------------------------------------------------
+// DamageManager accessor.
+//---------------------------------------------------------------------------------
+CDamageManager* get_damage_manager()
+{
+	return &s_DamageManager;
+}
+
+//---------------------------------------------------------------------------------
+// void CBaseEntity::TakeDamage(const CTakeDamageInfo&)
+//---------------------------------------------------------------------------------
+HookRetBuf_t* TakeDamagePre( CDetour* pDetour )
+{
+	void* pVictim = *(void **) GetArgumentAddress(pDetour, 0);
+	void* pInfo = *(void **) GetArgumentAddress(pDetour, 1);
+
+	HookRetBuf_t* buffer = new HookRetBuf_t;
+	buffer->eRes = s_DamageManager.take_damage(pVictim, pInfo) ? HOOKRES_NONE : HOOKRES_OVERRIDE;
+	buffer->pRetBuf = NULL;
+	return buffer;
+}
+
+//---------------------------------------------------------------------------------
+// CTakeDamageInfoView code.
+//---------------------------------------------------------------------------------
+CTakeDamageInfoView::CTakeDamageInfoView( void* pInfo, const DamageInfoOffsets_t* pOffsets, int iVictim, int iHitGroup )
+{
+	m_pInfo = pInfo;
+	m_pOffsets = pOffsets;
+	m_iVictim = iVictim;
+	m_iHitGroup = iHitGroup;
+}
+
+int CTakeDamageInfoView::get_victim()
+{
+	get_info();
+	return m_iVictim;
+}
+
+int CTakeDamageInfoView::get_inflictor()
+{
+	return get_handle_index(m_pOffsets->inflictor);
+}
+
+int CTakeDamageInfoView::get_attacker()
+{
+	return get_handle_index(m_pOffsets->attacker);
+}
+
+int CTakeDamageInfoView::get_weapon()
+{
+	return get_handle_index(m_pOffsets->weapon);
+}
+
+int CTakeDamageInfoView::get_hitgroup()
+{
+	get_info();
+	return m_iHitGroup;
+}
+
+float CTakeDamageInfoView::get_damage()
+{
+	return *(float *) ((char *) get_info() + m_pOffsets->damage);
+}
+
+void CTakeDamageInfoView::set_damage( float flDamage )
+{
+	*(float *) ((char *) get_info() + m_pOffsets->damage) = flDamage;
+}
+
+int CTakeDamageInfoView::get_damage_type()
+{
+	return *(int *) ((char *) get_info() + m_pOffsets->damage_type);
+}
+
+void CTakeDamageInfoView::set_damage_type( int iDamageType )
+{
+	*(int *) ((char *) get_info() + m_pOffsets->damage_type) = iDamageType;
+}
+
+unsigned long CTakeDamageInfoView::get_pointer()
+{
+	return (unsigned long) get_info();
+}
+
+int CTakeDamageInfoView::get_handle_index( int offset )
+{
+	void* pInfo = get_info();
+	if( offset < 0 )
+		return -1;
+
+	return ResolveIntHandle(*(int *) ((char *) pInfo + offset));
+}
+
+void CTakeDamageInfoView::invalidate()
+{
+	m_pInfo = NULL;
+}
+
+void* CTakeDamageInfoView::get_info()
+{
+	if( !m_pInfo )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "The damage info is only valid during the callback.")
+
+	return m_pInfo;
+}
+
+//---------------------------------------------------------------------------------
+// CDamageManager code.
+//---------------------------------------------------------------------------------
+CDamageManager::CDamageManager()
+{
+	m_pTakeDamage = NULL;
+	m_bHooked = false;
+	m_iNextID = 1;
+
+	m_Offsets.inflictor = -1;
+	m_Offsets.attacker = -1;
+	m_Offsets.weapon = -1;
+	m_Offsets.damage = -1;
+	m_Offsets.damage_type = -1;
+}
+
+void CDamageManager::set_take_damage_function( object pointer )
+{
+	// The detour can't be moved once it was created.
+	if( m_bHooked )
+		return;
+
+	m_pTakeDamage = (void *) ExtractPyPtr(pointer);
+}
+
+void CDamageManager::set_info_offsets( int inflictor, int attacker, int weapon, int damage, int damage_type )
+{
+	m_Offsets.inflictor = inflictor;
+	m_Offsets.attacker = attacker;
+	m_Offsets.weapon = weapon;
+	m_Offsets.damage = damage;
+	m_Offsets.damage_type = damage_type;
+}
+
+bool CDamageManager::install_hook()
+{
+	if( m_bHooked )
+		return true;
+
+	if( !m_pTakeDamage )
+		return false;
+
+	m_bHooked = CPP_CreateCallback(m_pTakeDamage, CONV_THISCALL, "p)v", &TakeDamagePre, TYPE_PRE);
+	return m_bHooked;
+}
+
+int CDamageManager::add_rule( DamageAction action, float value /* = 1.0f */, int attacker_team /* = 0 */,
+	int victim_team /* = 0 */, const char* weapon /* = "" */, int hitgroup /* = -1 */, int damage_type /* = 0 */,
+	object callback /* = object() */ )
+{
+	if( action == DAMAGE_CALLBACK && !PyCallable_Check(callback.ptr()) )
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Callback is not callable.")
+
+	if( m_Offsets.damage < 0 || m_Offsets.damage_type < 0 )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "CTakeDamageInfo offsets are not set.")
+
+	if( !install_hook() )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Failed to hook TakeDamage.")
+
+	DamageRule_t rule;
+	rule.id = m_iNextID++;
+	rule.action = action;
+	rule.value = value;
+	rule.attacker_team = attacker_team;
+	rule.victim_team = victim_team;
+	rule.weapon = weapon;
+	rule.hitgroup = hitgroup;
+	rule.damage_type = damage_type;
+	rule.callback = callback;
+
+	// Ids grow, so the table stays sorted by id.
+	m_Rules.push_back(rule);
+	return rule.id;
+}
+
+void CDamageManager::remove_rule( int id )
+{
+	for( std::vector<DamageRule_t>::iterator it = m_Rules.begin(); it != m_Rules.end(); ++it )
+	{
+		if( it->id == id )
+		{
+			m_Rules.erase(it);
+			return;
+		}
+	}
+}
+
+int CDamageManager::get_count()
+{
+	return (int) m_Rules.size();
+}
+
+void CDamageManager::clear()
+{
+	m_Rules.clear();
+}
+
+bool CDamageManager::take_damage( void* pVictim, void* pInfo )
+{
+	if( m_Rules.empty() )
+		return true;
+
+	edict_t* pVictimEdict = EdictOfBaseEntity(pVictim);
+	if( !pVictimEdict || pVictimEdict->IsFree() )
+		return true;
+
+	int iVictim = IndexOfEdict(pVictimEdict);
+	float* pDamage = (float *) ((char *) pInfo + m_Offsets.damage);
+	int iDamageType = *(int *) ((char *) pInfo + m_Offsets.damage_type);
+
+	// Everything else is only looked up if a rule filters by it.
+	int iAttackerTeam = -1;
+	int iVictimTeam = -1;
+	int iHitGroup = -2;
+	const char* szWeapon = NULL;
+
+	unsigned int i = 0;
+	while( i < m_Rules.size() )
+	{
+		const DamageRule_t& rule = m_Rules[i++];
+		if( rule.damage_type && !(iDamageType & rule.damage_type) )
+			continue;
+
+		if( rule.victim_team )
+		{
+			if( iVictimTeam == -1 )
+				iVictimTeam = TeamOfEdict(pVictimEdict, iVictim);
+
+			if( iVictimTeam != rule.victim_team )
+				continue;
+		}
+
+		if( rule.attacker_team )
+		{
+			if( iAttackerTeam == -1 )
+			{
+				int iAttacker = m_Offsets.attacker < 0 ? -1 : ResolveIntHandle(*(int *) ((char *) pInfo + m_Offsets.attacker));
+				edict_t* pAttacker = iAttacker == -1 ? NULL : PEntityOfEntIndex(iAttacker);
+				iAttackerTeam = pAttacker ? TeamOfEdict(pAttacker, iAttacker) : 0;
+			}
+
+			if( iAttackerTeam != rule.attacker_team )
+				continue;
+		}
+
+		if( rule.hitgroup != -1 || rule.action == DAMAGE_CALLBACK )
+		{
+			if( iHitGroup == -2 )
+				iHitGroup = get_hitgroup(pVictimEdict, iVictim);
+
+			if( rule.hitgroup != -1 && iHitGroup != rule.hitgroup )
+				continue;
+		}
+
+		if( !rule.weapon.empty() )
+		{
+			if( !szWeapon )
+				szWeapon = get_weapon_classname(pInfo);
+
+			if( V_stricmp(rule.weapon.c_str(), szWeapon) != 0 )
+				continue;
+		}
+
+		switch( rule.action )
+		{
+			case DAMAGE_MULTIPLY:
+				*pDamage *= rule.value;
+				break;
+
+			case DAMAGE_CLAMP:
+				if( *pDamage > rule.value )
+					*pDamage = rule.value;
+				break;
+
+			case DAMAGE_BLOCK:
+				return false;
+
+			case DAMAGE_CALLBACK:
+			{
+				// The callback may change the rule table, so the rule is copied
+				// and the next rule is looked up by id afterwards.
+				int id = rule.id;
+				object callback = rule.callback;
+				bool bBlocked = false;
+
+				// Python owns the view, because the callback may keep a reference.
+				CTakeDamageInfoView* pView = new CTakeDamageInfoView(pInfo, &m_Offsets, iVictim, iHitGroup);
+				manage_new_object::apply<CTakeDamageInfoView *>::type convert;
+				object view(handle<>(convert(pView)));
+
+				BEGIN_BOOST_PY()
+
+					object result = callback(view);
+					bBlocked = !result.is_none() && !extract<bool>(result);
+
+				END_BOOST_PY_NORET()
+
+				// The CTakeDamageInfo doesn't outlive the hit.
+				pView->invalidate();
+
+				if( bBlocked )
+					return false;
+
+				// The damage type may have been changed by the callback.
+				iDamageType = *(int *) ((char *) pInfo + m_Offsets.damage_type);
+
+				i = 0;
+				while( i < m_Rules.size() && m_Rules[i].id <= id )
+					i++;
+			} break;
+		}
+	}
+
+	return true;
+}
+
+int CDamageManager::get_hitgroup( edict_t* pEdict, int index )
+{
+	// Only players record the hitgroup of the last trace attack.
+	if( index <= 0 || index > gpGlobals->maxClients )
+		return 0;
+
+	CDataMapTable* pTable = UTIL_GetDataMapTable(pEdict);
+	if( !pTable )
+		return 0;
+
+	const CDataMapOffset* pField = pTable->get_offset("m_LastHitGroup");
+	if( !pField )
+		return 0;
+
+	return *(int *) ((char *) pEdict->GetUnknown()->GetBaseEntity() + pField->offset);
+}
+
+const char* CDamageManager::get_weapon_classname( void* pInfo )
+{
+	// Projectiles don't set the weapon, so their inflictor is used instead.
+	int offsets[2] = {m_Offsets.weapon, m_Offsets.inflictor};
+	for( int i = 0; i < 2; i++ )
+	{
+		if( offsets[i] < 0 )
+			continue;
+
+		int index = ResolveIntHandle(*(int *) ((char *) pInfo + offsets[i]));
+		if( index == -1 )
+			continue;
+
+		edict_t* pEdict = PEntityOfEntIndex(index);
+		if( pEdict && !pEdict->IsFree() )
+			return pEdict->GetClassName();
+	}
+
+	return "";
+}
@@ -0,0 +1,160 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _ENTITIES_DAMAGE_H
+#define _ENTITIES_DAMAGE_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include "edict.h"
+#include "utility/wrap_macros.h"
+
+//---------------------------------------------------------------------------------
+// Actions of a damage rule.
+//---------------------------------------------------------------------------------
+enum DamageAction
+{
+	DAMAGE_MULTIPLY = 0,	// Multiplies the damage by the rule's value.
+	DAMAGE_CLAMP,			// Caps the damage at the rule's value.
+	DAMAGE_BLOCK,			// Blocks the hit.
+	DAMAGE_CALLBACK			// Passes the hit to the rule's callback.
+};
+
+//---------------------------------------------------------------------------------
+// Offsets of the CTakeDamageInfo members that are read natively.
+//---------------------------------------------------------------------------------
+struct DamageInfoOffsets_t
+{
+	int inflictor;
+	int attacker;
+	int weapon;
+	int damage;
+	int damage_type;
+};
+
+//---------------------------------------------------------------------------------
+// Typed view of the CTakeDamageInfo of a hit. It points into the game's
+// memory, so it is invalidated once the callback returned. Accessing it after
+// that raises an exception.
+//---------------------------------------------------------------------------------
+class CTakeDamageInfoView
+{
+public:
+	CTakeDamageInfoView( void* pInfo, const DamageInfoOffsets_t* pOffsets, int iVictim, int iHitGroup );
+
+	int				get_victim();
+	int				get_inflictor();
+	int				get_attacker();
+	int				get_weapon();
+	int				get_hitgroup();
+
+	float			get_damage();
+	void			set_damage( float flDamage );
+
+	int				get_damage_type();
+	void			set_damage_type( int iDamageType );
+
+	// Address of the CTakeDamageInfo, for members that aren't wrapped here.
+	unsigned long	get_pointer();
+
+	// Detaches the view from the CTakeDamageInfo.
+	void			invalidate();
+
+private:
+	int				get_handle_index( int offset );
+	void*			get_info();
+
+private:
+	void*						m_pInfo;
+	const DamageInfoOffsets_t*	m_pOffsets;
+	int							m_iVictim;
+	int							m_iHitGroup;
+};
+
+//---------------------------------------------------------------------------------
+// Native damage pipeline. CBaseEntity::TakeDamage is detoured the first time a
+// rule is added. Every hit is matched against the rule table in C++ and the
+// multiply, clamp and block rules are applied without calling into Python.
+// Python only sees the hits that match a callback rule.
+//---------------------------------------------------------------------------------
+class CDamageManager
+{
+public:
+	CDamageManager();
+
+	// Sets the address of CBaseEntity::TakeDamage.
+	void	set_take_damage_function( object pointer );
+
+	// Sets the offsets of the CTakeDamageInfo members.
+	void	set_info_offsets( int inflictor, int attacker, int weapon, int damage, int damage_type );
+
+	// Adds a rule and returns its id. Rules are applied in the order they were
+	// added. Filters of 0, -1 or "" match every hit. damage_type matches hits
+	// that have any of the given bits. Callbacks are called with a
+	// CTakeDamageInfoView and block the hit by returning False.
+	int		add_rule( DamageAction action, float value = 1.0f, int attacker_team = 0, int victim_team = 0,
+				const char* weapon = "", int hitgroup = -1, int damage_type = 0, object callback = object() );
+
+	void	remove_rule( int id );
+	int		get_count();
+
+	// Drops all rules.
+	void	clear();
+
+	// Called by the TakeDamage hook. Returns false if the hit is blocked.
+	bool	take_damage( void* pVictim, void* pInfo );
+
+private:
+	struct DamageRule_t
+	{
+		int				id;
+		DamageAction	action;
+		float			value;
+		int				attacker_team;
+		int				victim_team;
+		std::string		weapon;
+		int				hitgroup;
+		int				damage_type;
+		object			callback;
+	};
+
+	bool		install_hook();
+	int			get_hitgroup( edict_t* pEdict, int index );
+	const char*	get_weapon_classname( void* pInfo );
+
+private:
+	void*						m_pTakeDamage;
+	bool						m_bHooked;
+	int							m_iNextID;
+	DamageInfoOffsets_t			m_Offsets;
+	std::vector<DamageRule_t>	m_Rules;
+};
+
+CDamageManager* get_damage_manager();
+
+#endif // _ENTITIES_DAMAGE_H
@@ -0,0 +1,399 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "entities_datamaps.h"
+#include "dyncall.h"
+#include "modules/memory/memory_tools.h"
+#include "utility/wrap_macros.h"
+#include "string_t.h"
+#include "boost/algorithm/string.hpp"
+
+//---------------------------------------------------------------------------------
+// External variables.
+//---------------------------------------------------------------------------------
+extern DCCallVM* g_pCallVM;
+
+//---------------------------------------------------------------------------------
+// Global accessor.
+//---------------------------------------------------------------------------------
+typedef boost::unordered_map<std::string, CDataMapTable*> DataMapTableMap;
+DataMapTableMap g_DataMapTableMap;
+
+// -1 means the index was not set from the data files yet.
+static int s_iDataDescMapIndex = -1;
+
+//---------------------------------------------------------------------------------
+// Helper functions.
+//---------------------------------------------------------------------------------
+void set_datamap_vtable_index( int iIndex )
+{
+	s_iDataDescMapIndex = iIndex;
+}
+
+int get_datamap_vtable_index()
+{
+	return s_iDataDescMapIndex;
+}
+
+datamap_t* UTIL_GetDataDescMap( CBaseEntity* pEntity )
+{
+	if( !pEntity || s_iDataDescMapIndex < 0 )
+		return NULL;
+
+	int iIndex = s_iDataDescMapIndex;
+#ifdef __linux__
+	iIndex++;
+#endif
+
+	void** vtable = *(void ***) pEntity;
+	if( !vtable )
+		return NULL;
+
+	// datamap_t* CBaseEntity::GetDataDescMap()
+	dcReset(g_pCallVM);
+	dcMode(g_pCallVM, _CONV_THISCALL);
+	dcArgPointer(g_pCallVM, (DCpointer) pEntity);
+	return (datamap_t *) dcCallPointer(g_pCallVM, (DCpointer) vtable[iIndex]);
+}
+
+CDataMapTable* UTIL_GetDataMapTable( edict_t* pEdict )
+{
+	if( !pEdict || pEdict->IsFree() )
+		return NULL;
+
+	// Get the class' table if we already walked its datamap.
+	const char* szClassName = pEdict->GetClassName();
+	DataMapTableMap::iterator tableIter = g_DataMapTableMap.find(szClassName);
+	if( tableIter != g_DataMapTableMap.end() )
+		return tableIter->second;
+
+	IServerUnknown* pUnknown = pEdict->GetUnknown();
+	if( !pUnknown )
+		return NULL;
+
+	datamap_t* pDataMap = UTIL_GetDataDescMap(pUnknown->GetBaseEntity());
+	if( !pDataMap )
+		return NULL;
+
+	// Walk the datamap once and cache it by classname.
+	CDataMapTable* pTable = new CDataMapTable(pDataMap);
+	g_DataMapTableMap.insert(std::make_pair(szClassName, pTable));
+	return pTable;
+}
+
+//---------------------------------------------------------------------------------
+// CDataMapTable code.
+//---------------------------------------------------------------------------------
+CDataMapTable::CDataMapTable( datamap_t* datamap )
+{
+	add_fields(datamap, "", 0);
+}
+
+const CDataMapOffset* CDataMapTable::get_offset( const char* field_name ) const
+{
+	boost::unordered_map<std::string, CDataMapOffset>::const_iterator fieldIter = m_fields.find(field_name);
+	if( fieldIter == m_fields.end() )
+		return NULL;
+
+	return &fieldIter->second;
+}
+
+const CDataMapOffset* CDataMapTable::get_key( const char* key_name ) const
+{
+	std::string key = key_name;
+	boost::algorithm::to_lower(key);
+
+	boost::unordered_map<std::string, CDataMapOffset>::const_iterator keyIter = m_keys.find(key);
+	if( keyIter == m_keys.end() )
+		return NULL;
+
+	return &keyIter->second;
+}
+
+const char* CDataMapTable::get_output_name( int offset ) const
+{
+	boost::unordered_map<int, std::string>::const_iterator outputIter = m_outputs.find(offset);
+	if( outputIter == m_outputs.end() )
+		return NULL;
+
+	return outputIter->second.c_str();
+}
+
+void CDataMapTable::add_fields( datamap_t* datamap, const std::string& prefix, int base_offset )
+{
+	// Walk the given map and all of its base maps. Fields of derived
+	// classes are added first, so they win over base class fields.
+	for( ; datamap; datamap = datamap->baseMap )
+	{
+		for( int i = 0; i < datamap->dataNumFields; i++ )
+		{
+			typedescription_t* pField = &datamap->dataDesc[i];
+			if( !pField->fieldName )
+				continue;
+
+#if( SOURCE_ENGINE >= 3 )
+			int iOffset = base_offset + pField->fieldOffset;
+#else
+			int iOffset = base_offset + pField->fieldOffset[TD_OFFSET_NORMAL];
+#endif
+			std::string name = prefix + pField->fieldName;
+
+			// Embedded structures are flattened into "m_Outer.m_Inner" names.
+			if( pField->fieldType == FIELD_EMBEDDED )
+			{
+				if( pField->td && !(pField->flags & FTYPEDESC_PTR) )
+					add_fields(pField->td, name + ".", iOffset);
+
+				continue;
+			}
+
+			CDataMapOffset field;
+			field.offset = iOffset;
+			field.type = pField->fieldType;
+			field.count = pField->fieldSize;
+			field.size_in_bytes = pField->fieldSizeInBytes;
+			m_fields.insert(std::make_pair(name, field));
+
+			if( (pField->flags & FTYPEDESC_OUTPUT) && pField->externalName )
+				m_outputs.insert(std::make_pair(iOffset, std::string(pField->externalName)));
+
+			// Fields that can be set by a keyvalue are also stored by their key.
+			if( (pField->flags & FTYPEDESC_KEY) && pField->externalName )
+			{
+				std::string key = pField->externalName;
+				boost::algorithm::to_lower(key);
+				m_keys.insert(std::make_pair(key, field));
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------------------------------
+// CDataMapProp code.
+//---------------------------------------------------------------------------------
+CDataMapProp::CDataMapProp( edict_t* edict, const char* field_name )
+{
+	// Set default values.
+	m_base_entity = NULL;
+	m_field = NULL;
+	m_edict = edict;
+
+	if( !m_edict || m_edict->IsFree() )
+	{
+		DevMsg(1, "[SP]: edict was not valid!\n");
+		return;
+	}
+
+	IServerUnknown* pUnknown = m_edict->GetUnknown();
+	if( !pUnknown )
+	{
+		DevMsg(1, "[SP]: edict has no entity!\n");
+		return;
+	}
+
+	m_base_entity = pUnknown->GetBaseEntity();
+
+	CDataMapTable* pTable = UTIL_GetDataMapTable(m_edict);
+	if( !pTable )
+	{
+		DevMsg(1, "[SP]: could not get the datamap of '%s'!\n", m_edict->GetClassName());
+		return;
+	}
+
+	m_field = pTable->get_offset(field_name);
+	if( !m_field )
+		DevMsg(1, "[SP]: datamap field '%s' was not found!\n", field_name);
+}
+
+fieldtype_t CDataMapProp::get_type()
+{
+	if( m_field )
+		return m_field->type;
+
+	return FIELD_VOID;
+}
+
+int CDataMapProp::get_offset()
+{
+	if( m_field )
+		return m_field->offset;
+
+	return -1;
+}
+
+void CDataMapProp::set_int( int value )
+{
+	if( !m_field )
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Field is not an integer.")
+
+	char* pData = (char *) m_base_entity + m_field->offset;
+	switch( m_field->type )
+	{
+		case FIELD_INTEGER:
+		case FIELD_TICK:
+		case FIELD_MODELINDEX:
+		case FIELD_MATERIALINDEX:
+		case FIELD_COLOR32:
+		case FIELD_EHANDLE:
+			*(int *) pData = value;
+			break;
+
+		case FIELD_SHORT:
+			*(short *) pData = (short) value;
+			break;
+
+		case FIELD_BOOLEAN:
+			*(bool *) pData = (value != 0);
+			break;
+
+		case FIELD_CHARACTER:
+			*(char *) pData = (char) value;
+			break;
+
+		default:
+			BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Field is not an integer.")
+	}
+
+	// Force a network update in case the field is networked as well.
+	m_edict->StateChanged(m_field->offset);
+}
+
+void CDataMapProp::set_float( float value )
+{
+	if( m_field && (m_field->type == FIELD_FLOAT || m_field->type == FIELD_TIME) )
+	{
+		*(float *)((char *)m_base_entity + m_field->offset) = value;
+
+		// Force a network update in case the field is networked as well.
+		m_edict->StateChanged(m_field->offset);
+	}
+	else
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Field is not a float.")
+}
+
+void CDataMapProp::set_string( const char* value )
+{
+	// Only inline character buffers can be written. string_t fields point into
+	// the game's string pool, which we don't own.
+	if( m_field && m_field->type == FIELD_CHARACTER && m_field->count > 1 )
+	{
+		V_strncpy((char *) m_base_entity + m_field->offset, value, m_field->count);
+
+		// Force a network update in case the field is networked as well.
+		m_edict->StateChanged(m_field->offset);
+	}
+	else
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Field is not a writable string.")
+}
+
+void CDataMapProp::set_vector( CVector* pVec )
+{
+	if( m_field && (m_field->type == FIELD_VECTOR || m_field->type == FIELD_POSITION_VECTOR) )
+	{
+		*(Vector *)((char *)m_base_entity + m_field->offset) = *(Vector *) pVec;
+
+		// Force a network update in case the field is networked as well.
+		m_edict->StateChanged(m_field->offset);
+	}
+	else
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Field is not a vector.")
+}
+
+int CDataMapProp::get_int()
+{
+	if( m_field )
+	{
+		char* pData = (char *) m_base_entity + m_field->offset;
+		switch( m_field->type )
+		{
+			case FIELD_INTEGER:
+			case FIELD_TICK:
+			case FIELD_MODELINDEX:
+			case FIELD_MATERIALINDEX:
+			case FIELD_COLOR32:
+			case FIELD_EHANDLE:
+				return *(int *) pData;
+
+			case FIELD_SHORT:
+				return *(short *) pData;
+
+			case FIELD_BOOLEAN:
+				return *(bool *) pData;
+
+			case FIELD_CHARACTER:
+				return *(char *) pData;
+		}
+	}
+
+	BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Field is not an integer.")
+	return -1;
+}
+
+float CDataMapProp::get_float()
+{
+	if( m_field && (m_field->type == FIELD_FLOAT || m_field->type == FIELD_TIME) )
+	{
+		return *(float *)((char *)m_base_entity + m_field->offset);
+	}
+
+	BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Field is not a float.")
+	return -1.0f;
+}
+
+const char* CDataMapProp::get_string()
+{
+	if( m_field )
+	{
+		char* pData = (char *) m_base_entity + m_field->offset;
+		switch( m_field->type )
+		{
+			case FIELD_STRING:
+			case FIELD_MODELNAME:
+			case FIELD_SOUNDNAME:
+				return STRING(*(string_t *) pData);
+
+			case FIELD_CHARACTER:
+				return (const char *) pData;
+		}
+	}
+
+	BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Field is not a string.")
+	return "";
+}
+
+CVector* CDataMapProp::get_vector()
+{
+	if( m_field && (m_field->type == FIELD_VECTOR || m_field->type == FIELD_POSITION_VECTOR) )
+	{
+		return new CVector(*(Vector *) ((char *)m_base_entity + m_field->offset));
+	}
+
+	BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Field is not a vector.")
+	return NULL;
+}
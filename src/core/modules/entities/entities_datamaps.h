@@ -0,0 +1,128 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _ENTITIES_DATAMAPS_H
+#define _ENTITIES_DATAMAPS_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <string>
+#include "edict.h"
+#include "datamap.h"
+#include "boost/unordered_map.hpp"
+#include "modules/vecmath/vecmath_wrap.h"
+
+//---------------------------------------------------------------------------------
+// Every datamap field is stored with its absolute offset in the entity, its type
+// and the number of elements (for arrays).
+//---------------------------------------------------------------------------------
+class CDataMapOffset
+{
+public:
+	int				offset;
+	fieldtype_t		type;
+	int				count;
+	int				size_in_bytes;
+};
+
+//---------------------------------------------------------------------------------
+// Flattened datamap of a single entity class. The whole datamap chain
+// (including base maps and embedded fields) is walked once and cached by name.
+//---------------------------------------------------------------------------------
+class CDataMapTable
+{
+public:
+	CDataMapTable( datamap_t* datamap );
+
+	// Returns the cached field, or NULL if the class has no such field.
+	const CDataMapOffset* get_offset( const char* field_name ) const;
+
+	// Returns the field of a keyvalue (case insensitive), or NULL if the key
+	// isn't described in the datamap.
+	const CDataMapOffset* get_key( const char* key_name ) const;
+
+	// Returns the external name of the output at the given offset, or NULL if
+	// there is no output at that offset.
+	const char* get_output_name( int offset ) const;
+
+private:
+	void add_fields( datamap_t* datamap, const std::string& prefix, int base_offset );
+
+private:
+	boost::unordered_map<std::string, CDataMapOffset> m_fields;
+
+	// Keyvalue fields by their lower case external name.
+	boost::unordered_map<std::string, CDataMapOffset> m_keys;
+
+	// Output names (e.g. "OnTrigger") by their offset.
+	boost::unordered_map<int, std::string> m_outputs;
+};
+
+//---------------------------------------------------------------------------------
+// Custom datamap field wrapper. Works like CSendProp, but for any field that
+// is described in the entity's datamap.
+//---------------------------------------------------------------------------------
+class CDataMapProp
+{
+public:
+	CDataMapProp( edict_t* edict, const char* field_name );
+
+	fieldtype_t		get_type();
+	int				get_offset();
+
+	void			set_int( int value );
+	void			set_float( float value );
+	void			set_string( const char* value );
+	void			set_vector( CVector* pVec );
+
+	int				get_int();
+	float			get_float();
+	const char*		get_string();
+	CVector*		get_vector();
+
+private:
+	// Base entity instance.
+	CBaseEntity*			m_base_entity;
+
+	// Edict instance.
+	edict_t*				m_edict;
+
+	// The cached field. This is owned by the class' datamap table.
+	const CDataMapOffset*	m_field;
+};
+
+//---------------------------------------------------------------------------------
+// Helper functions
+//---------------------------------------------------------------------------------
+// The vtable index of CBaseEntity::GetDataDescMap. The platform difference
+// is applied the same way CPointer::get_virtual_func does it.
+void			set_datamap_vtable_index( int iIndex );
+int				get_datamap_vtable_index();
+
+datamap_t*		UTIL_GetDataDescMap( CBaseEntity* pEntity );
+CDataMapTable*	UTIL_GetDataMapTable( edict_t* pEdict );
+
+#endif // _ENTITIES_DATAMAPS_H
@@ -0,0 +1,427 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "entities_datastore.h"
+#include "const.h"
+#include "modules/vecmath/vecmath_wrap.h"
+
+//---------------------------------------------------------------------------------
+// All stores. They live until the plugin is unloaded.
+//---------------------------------------------------------------------------------
+static std::vector<CDataStore*> s_DataStores;
+
+//---------------------------------------------------------------------------------
+// CDataStoreField code.
+//---------------------------------------------------------------------------------
+CDataStoreField::CDataStoreField( const char* name, DataStoreFieldType type, int size, int rows )
+{
+	m_name = name;
+	m_type = type;
+	m_iRows = rows;
+
+	switch( type )
+	{
+		case DATASTORE_INT:		m_iSize = 1; m_iStride = sizeof(int); break;
+		case DATASTORE_FLOAT:	m_iSize = 1; m_iStride = sizeof(float); break;
+		case DATASTORE_VECTOR:	m_iSize = 3; m_iStride = 3 * sizeof(float); break;
+		default:				m_iSize = size; m_iStride = size; break;
+	}
+
+	m_pData = new char[m_iStride * m_iRows];
+	reset_all();
+}
+
+CDataStoreField::~CDataStoreField()
+{
+	delete [] m_pData;
+}
+
+const char* CDataStoreField::get_name()
+{
+	return m_name.c_str();
+}
+
+DataStoreFieldType CDataStoreField::get_type()
+{
+	return m_type;
+}
+
+int CDataStoreField::get_size()
+{
+	return m_iSize;
+}
+
+char* CDataStoreField::get_row( int index )
+{
+	if( index < 0 || index >= m_iRows )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid index.")
+
+	return m_pData + index * m_iStride;
+}
+
+object CDataStoreField::get( int index )
+{
+	char* pRow = get_row(index);
+	switch( m_type )
+	{
+		case DATASTORE_INT:
+			return object(*(int *) pRow);
+
+		case DATASTORE_FLOAT:
+			return object(*(float *) pRow);
+
+		case DATASTORE_VECTOR:
+		{
+			float* pValues = (float *) pRow;
+			return object(CVector(pValues[0], pValues[1], pValues[2]));
+		}
+	}
+
+	return object(handle<>(PyBytes_FromStringAndSize(pRow, m_iStride)));
+}
+
+void CDataStoreField::set( int index, object value )
+{
+	char* pRow = get_row(index);
+	switch( m_type )
+	{
+		case DATASTORE_INT:
+			*(int *) pRow = extract<int>(value);
+			return;
+
+		case DATASTORE_FLOAT:
+			*(float *) pRow = extract<float>(value);
+			return;
+
+		case DATASTORE_VECTOR:
+		{
+			float* pValues = (float *) pRow;
+			extract<CVector&> vec(value);
+			if( vec.check() )
+			{
+				Vector vecValue = vec();
+				pValues[0] = vecValue.x;
+				pValues[1] = vecValue.y;
+				pValues[2] = vecValue.z;
+				return;
+			}
+
+			if( len(value) != 3 )
+				BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Expected a Vector or three floats.")
+
+			for( int i = 0; i < 3; i++ )
+				pValues[i] = extract<float>(value[i]);
+
+			return;
+		}
+	}
+
+	char* szData;
+	Py_ssize_t iLength;
+	if( PyBytes_AsStringAndSize(value.ptr(), &szData, &iLength) == -1 )
+		throw_error_already_set();
+
+	if( iLength > m_iStride )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Value is longer than the field.")
+
+	memcpy(pRow, szData, iLength);
+	memset(pRow + iLength, 0, m_iStride - iLength);
+}
+
+void CDataStoreField::reset( int index )
+{
+	memset(get_row(index), 0, m_iStride);
+}
+
+void CDataStoreField::reset_all()
+{
+	memset(m_pData, 0, m_iStride * m_iRows);
+}
+
+object CDataStoreField::get_view()
+{
+	if( m_View.is_none() )
+	{
+		object bytes_view(handle<>(PyMemoryView_FromMemory(m_pData, m_iStride * m_iRows, PyBUF_WRITE)));
+		switch( m_type )
+		{
+			case DATASTORE_INT:		m_View = bytes_view.attr("cast")("i"); break;
+			case DATASTORE_BYTES:	m_View = bytes_view; break;
+			default:				m_View = bytes_view.attr("cast")("f"); break;
+		}
+	}
+
+	return m_View;
+}
+
+void CDataStoreField::release_view()
+{
+	if( m_View.is_none() )
+		return;
+
+	// Views that scripts still hold raise ValueError from now on. Views with
+	// exported buffers can't be released, but no Python code runs after this.
+	PyObject* pResult = PyObject_CallMethod(m_View.ptr(), "release", NULL);
+	if( pResult )
+		Py_DECREF(pResult);
+	else
+		PyErr_Clear();
+
+	m_View = object();
+}
+
+//---------------------------------------------------------------------------------
+// CDataStore code.
+//---------------------------------------------------------------------------------
+CDataStore::CDataStore( const char* name, DataStoreScope scope )
+{
+	m_name = name;
+	m_scope = scope;
+	m_iRows = scope == DATASTORE_PLAYERS ? ABSOLUTE_PLAYER_LIMIT + 1 : MAX_EDICTS;
+}
+
+CDataStore::~CDataStore()
+{
+	for( unsigned int i = 0; i < m_Fields.size(); i++ )
+		delete m_Fields[i];
+}
+
+const char* CDataStore::get_name()
+{
+	return m_name.c_str();
+}
+
+DataStoreScope CDataStore::get_scope()
+{
+	return m_scope;
+}
+
+int CDataStore::get_row_count()
+{
+	return m_iRows;
+}
+
+CDataStoreField* CDataStore::add_field( const char* name, DataStoreFieldType type, int size /* = 0 */ )
+{
+	if( type == DATASTORE_BYTES && size <= 0 )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Bytes fields need a size.")
+
+	CDataStoreField* pField = find_field(name);
+	if( pField )
+	{
+		if( pField->get_type() != type || (type == DATASTORE_BYTES && pField->get_size() != size) )
+		{
+			PyErr_Format(PyExc_ValueError, "Field \"%s\" already exists with another type.", name);
+			throw_error_already_set();
+		}
+
+		return pField;
+	}
+
+	pField = new CDataStoreField(name, type, size, m_iRows);
+	m_Fields.push_back(pField);
+	m_FieldsByName[name] = pField;
+	return pField;
+}
+
+CDataStoreField* CDataStore::find_field( const char* name )
+{
+	boost::unordered_map<std::string, CDataStoreField*>::iterator it = m_FieldsByName.find(name);
+	return it == m_FieldsByName.end() ? NULL : it->second;
+}
+
+CDataStoreField* CDataStore::get_field( const char* name )
+{
+	CDataStoreField* pField = find_field(name);
+	if( !pField )
+	{
+		PyErr_Format(PyExc_KeyError, "Field \"%s\" doesn't exist.", name);
+		throw_error_already_set();
+	}
+
+	return pField;
+}
+
+bool CDataStore::has_field( const char* name )
+{
+	return find_field(name) != NULL;
+}
+
+object CDataStore::get_field_names()
+{
+	boost::python::list names;
+	for( unsigned int i = 0; i < m_Fields.size(); i++ )
+		names.append(m_Fields[i]->get_name());
+
+	return names;
+}
+
+CDataStoreRow* CDataStore::get_row( int index )
+{
+	if( index < 0 || index >= m_iRows )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid index.")
+
+	return new CDataStoreRow(this, index);
+}
+
+void CDataStore::reset_row( int index )
+{
+	if( index < 0 || index >= m_iRows )
+		return;
+
+	for( unsigned int i = 0; i < m_Fields.size(); i++ )
+		m_Fields[i]->reset(index);
+}
+
+void CDataStore::reset_all()
+{
+	for( unsigned int i = 0; i < m_Fields.size(); i++ )
+		m_Fields[i]->reset_all();
+}
+
+void CDataStore::release_views()
+{
+	for( unsigned int i = 0; i < m_Fields.size(); i++ )
+		m_Fields[i]->release_view();
+}
+
+//---------------------------------------------------------------------------------
+// CDataStoreRow code.
+//---------------------------------------------------------------------------------
+CDataStoreRow::CDataStoreRow( CDataStore* pStore, int index )
+{
+	m_pStore = pStore;
+	m_iIndex = index;
+}
+
+int CDataStoreRow::get_index()
+{
+	return m_iIndex;
+}
+
+CDataStore* CDataStoreRow::get_store()
+{
+	return m_pStore;
+}
+
+object CDataStoreRow::__getattr__( const char* name )
+{
+	CDataStoreField* pField = m_pStore->find_field(name);
+	if( !pField )
+	{
+		PyErr_Format(PyExc_AttributeError, "Field \"%s\" doesn't exist.", name);
+		throw_error_already_set();
+	}
+
+	return pField->get(m_iIndex);
+}
+
+void CDataStoreRow::__setattr__( const char* name, object value )
+{
+	CDataStoreField* pField = m_pStore->find_field(name);
+	if( !pField )
+	{
+		PyErr_Format(PyExc_AttributeError, "Field \"%s\" doesn't exist.", name);
+		throw_error_already_set();
+	}
+
+	pField->set(m_iIndex, value);
+}
+
+void CDataStoreRow::reset()
+{
+	m_pStore->reset_row(m_iIndex);
+}
+
+//---------------------------------------------------------------------------------
+// Exposed functions.
+//---------------------------------------------------------------------------------
+CDataStore* get_data_store( const char* name, DataStoreScope scope )
+{
+	for( unsigned int i = 0; i < s_DataStores.size(); i++ )
+	{
+		CDataStore* pStore = s_DataStores[i];
+		if( strcmp(pStore->get_name(), name) != 0 )
+			continue;
+
+		if( pStore->get_scope() != scope )
+		{
+			PyErr_Format(PyExc_ValueError, "Data store \"%s\" already exists with another scope.", name);
+			throw_error_already_set();
+		}
+
+		return pStore;
+	}
+
+	CDataStore* pStore = new CDataStore(name, scope);
+	s_DataStores.push_back(pStore);
+	return pStore;
+}
+
+//---------------------------------------------------------------------------------
+// Plugin callbacks.
+//---------------------------------------------------------------------------------
+void reset_player_data( int index )
+{
+	// The player's entity is gone as well, so edict rows are reset too.
+	for( unsigned int i = 0; i < s_DataStores.size(); i++ )
+		s_DataStores[i]->reset_row(index);
+}
+
+void reset_edict_data( int index )
+{
+	for( unsigned int i = 0; i < s_DataStores.size(); i++ )
+	{
+		if( s_DataStores[i]->get_scope() == DATASTORE_EDICTS )
+			s_DataStores[i]->reset_row(index);
+	}
+}
+
+void reset_edict_stores()
+{
+	for( unsigned int i = 0; i < s_DataStores.size(); i++ )
+	{
+		if( s_DataStores[i]->get_scope() == DATASTORE_EDICTS )
+			s_DataStores[i]->reset_all();
+	}
+}
+
+void release_data_store_views()
+{
+	for( unsigned int i = 0; i < s_DataStores.size(); i++ )
+		s_DataStores[i]->release_views();
+}
+
+void clear_data_stores()
+{
+	for( unsigned int i = 0; i < s_DataStores.size(); i++ )
+		delete s_DataStores[i];
+
+	s_DataStores.clear();
+}
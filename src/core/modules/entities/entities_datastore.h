@@ -0,0 +1,189 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _ENTITIES_DATASTORE_H
+#define _ENTITIES_DATASTORE_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include "boost/unordered_map.hpp"
+#include "utility/wrap_macros.h"
+
+//---------------------------------------------------------------------------------
+// Types of data store fields.
+//---------------------------------------------------------------------------------
+enum DataStoreFieldType
+{
+	DATASTORE_INT,		// One int per row.
+	DATASTORE_FLOAT,	// One float per row.
+	DATASTORE_VECTOR,	// Three floats per row.
+	DATASTORE_BYTES		// A fixed number of bytes per row.
+};
+
+//---------------------------------------------------------------------------------
+// What the rows of a data store are indexed by.
+//---------------------------------------------------------------------------------
+enum DataStoreScope
+{
+	DATASTORE_PLAYERS,	// One row per player slot.
+	DATASTORE_EDICTS	// One row per edict slot.
+};
+
+//---------------------------------------------------------------------------------
+// A single column. The buffer is allocated once and never moves, so the
+// memoryview of the column stays valid as long as the store exists.
+//---------------------------------------------------------------------------------
+class CDataStoreField
+{
+public:
+	CDataStoreField( const char* name, DataStoreFieldType type, int size, int rows );
+	~CDataStoreField();
+
+	const char*			get_name();
+	DataStoreFieldType	get_type();
+	int					get_size();
+
+	object				get( int index );
+	void				set( int index, object value );
+
+	// Zeroes a single row or all rows.
+	void				reset( int index );
+	void				reset_all();
+
+	// Returns a memoryview of the whole column.
+	object				get_view();
+
+	// Releases the memoryview, so Python can't access the column anymore.
+	void				release_view();
+
+private:
+	char*				get_row( int index );
+
+private:
+	std::string			m_name;
+	DataStoreFieldType	m_type;
+	int					m_iSize;
+	int					m_iStride;
+	int					m_iRows;
+	char*				m_pData;
+	object				m_View;
+};
+
+//---------------------------------------------------------------------------------
+// Typed column store with one row per player or edict slot. Rows are zeroed
+// when the player disconnects or the edict is freed, so addons don't have to
+// clean up their state themselves.
+//---------------------------------------------------------------------------------
+class CDataStoreRow;
+
+class CDataStore
+{
+public:
+	CDataStore( const char* name, DataStoreScope scope );
+	~CDataStore();
+
+	const char*			get_name();
+	DataStoreScope		get_scope();
+	int					get_row_count();
+
+	// Adds a field. Adding a field with the same name and type again returns
+	// the existing field, so reloaded addons get their columns back.
+	CDataStoreField*	add_field( const char* name, DataStoreFieldType type, int size = 0 );
+
+	CDataStoreField*	get_field( const char* name );
+	bool				has_field( const char* name );
+
+	// Returns a list with the names of all fields.
+	object				get_field_names();
+
+	// Returns an object that maps attribute access to the fields of a row.
+	CDataStoreRow*		get_row( int index );
+
+	void				reset_row( int index );
+	void				reset_all();
+	void				release_views();
+
+	// Returns the field or NULL.
+	CDataStoreField*	find_field( const char* name );
+
+private:
+	std::string			m_name;
+	DataStoreScope		m_scope;
+	int					m_iRows;
+
+	std::vector<CDataStoreField*>								m_Fields;
+	boost::unordered_map<std::string, CDataStoreField*>		m_FieldsByName;
+};
+
+//---------------------------------------------------------------------------------
+// Attribute access to a single row: row.kills += 1
+//---------------------------------------------------------------------------------
+class CDataStoreRow
+{
+public:
+	CDataStoreRow( CDataStore* pStore, int index );
+
+	int					get_index();
+	CDataStore*			get_store();
+
+	object				__getattr__( const char* name );
+	void				__setattr__( const char* name, object value );
+
+	void				reset();
+
+private:
+	CDataStore*			m_pStore;
+	int					m_iIndex;
+};
+
+//---------------------------------------------------------------------------------
+// Exposed functions.
+//---------------------------------------------------------------------------------
+// Returns the store with the given name. It's created if it doesn't exist yet.
+CDataStore* get_data_store( const char* name, DataStoreScope scope );
+
+//---------------------------------------------------------------------------------
+// Called by the plugin.
+//---------------------------------------------------------------------------------
+// Resets the rows of the player in all stores.
+void reset_player_data( int index );
+
+// Resets the rows of the edict in all edict stores.
+void reset_edict_data( int index );
+
+// Resets all rows of all edict stores. Player rows survive a map change.
+void reset_edict_stores();
+
+// Releases the memoryviews of all fields. Called before Python shuts down.
+void release_data_store_views();
+
+// Deletes all stores. Called after Python shut down, so no Python object can
+// reference them anymore.
+void clear_data_stores();
+
+#endif // _ENTITIES_DATASTORE_H
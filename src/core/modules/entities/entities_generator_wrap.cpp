@@ -29,6 +29,7 @@
 // ----------------------------------------------------------------------------
 #include "entities_generator_wrap.h"
 #include "entities_wrap.h"
+#include "entities_cache.h"
 #include "utility/sp_util.h"
 #include "boost/python/iterator.hpp"
 
@@ -91,10 +92,9 @@ CEntityGenerator::~CEntityGenerator()
 // ----------------------------------------------------------------------------
 // Returns the next valid CEdict instance.
 // ----------------------------------------------------------------------------
-CEdict* CEntityGenerator::getNext()
+object CEntityGenerator::getNext()
 {
 	edict_t* pEdict = NULL;
-	CEdict* pCEdict = NULL;
 	while(m_iEntityIndex < gpGlobals->maxEntities)
 	{
 		m_iEntityIndex++;
@@ -116,11 +116,10 @@ CEdict* CEntityGenerator::getNext()
 		}
 		if (pEdict)
 		{
-			pCEdict = new CEdict(pEdict);
-			return pCEdict;
+			return g_EdictCache.get_edict(pEdict);
 		}
 	}
-    return NULL;
+    return object();
 }
 
 //---------------------------------------------------------------------------------
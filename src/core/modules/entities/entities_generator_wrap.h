@@ -51,7 +51,7 @@ public:
 	virtual ~CEntityGenerator();
 
 protected:
-	virtual CEdict* getNext();
+	virtual object getNext();
 
 private:
 	int m_iEntityIndex;
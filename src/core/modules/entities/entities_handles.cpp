@@ -0,0 +1,142 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "entities_handles.h"
+#include "entities_props.h"
+#include "entities_datamaps.h"
+#include "utility/sp_util.h"
+
+//---------------------------------------------------------------------------------
+// Functions.
+//---------------------------------------------------------------------------------
+list indexes_from_inthandles( object handles )
+{
+	list indexes;
+
+	// Read buffers of 32 bit integers (like array('i')) directly.
+	PyObject* pHandles = handles.ptr();
+	if( PyObject_CheckBuffer(pHandles) )
+	{
+		Py_buffer view;
+		if( PyObject_GetBuffer(pHandles, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) == 0 )
+		{
+			if( view.itemsize == sizeof(int) && view.format && strchr("iIlL", view.format[0]) )
+			{
+				int* pData = (int *) view.buf;
+				int iCount = (int) (view.len / view.itemsize);
+				for( int i = 0; i < iCount; i++ )
+				{
+					indexes.append(ResolveIntHandle(pData[i]));
+				}
+
+				PyBuffer_Release(&view);
+				return indexes;
+			}
+
+			PyBuffer_Release(&view);
+		}
+		else
+		{
+			PyErr_Clear();
+		}
+	}
+
+	// Anything else must be an iterable of integers.
+	stl_input_iterator<int> iter(handles), end;
+	for( ; iter != end; ++iter )
+	{
+		indexes.append(ResolveIntHandle(*iter));
+	}
+
+	return indexes;
+}
+
+list UTIL_IndexesOfHandleArray( edict_t* pEdict, const char* prop_name )
+{
+	if( !pEdict || pEdict->IsFree() )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Entity is not valid.")
+
+	list indexes;
+	char* pBase = (char *) pEdict->GetUnknown()->GetBaseEntity();
+
+	// Is it a networked handle array?
+	int iOffset = 0;
+	SendProp* pProp = UTIL_GetSendProp(pEdict, prop_name, iOffset);
+	if( pProp )
+	{
+		switch( pProp->GetType() )
+		{
+			// Arrays created with SendPropArray3 are data tables with one
+			// prop per element.
+			case DPT_DataTable:
+			{
+				SendTable* pTable = pProp->GetDataTable();
+				for( int i = 0; i < pTable->GetNumProps(); i++ )
+				{
+					int iHandle = *(int *) (pBase + iOffset + pTable->GetProp(i)->GetOffset());
+					indexes.append(ResolveIntHandle(iHandle));
+				}
+				break;
+			}
+
+			case DPT_Array:
+			{
+				int iStride = pProp->GetElementStride();
+				for( int i = 0; i < pProp->GetNumElements(); i++ )
+				{
+					indexes.append(ResolveIntHandle(*(int *) (pBase + iOffset + i * iStride)));
+				}
+				break;
+			}
+
+			case DPT_Int:
+				indexes.append(ResolveIntHandle(*(int *) (pBase + iOffset)));
+				break;
+
+			default:
+				BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Property is not a handle array.")
+		}
+
+		return indexes;
+	}
+
+	// Is it a datamap field?
+	CDataMapTable* pTable = UTIL_GetDataMapTable(pEdict);
+	const CDataMapOffset* pField = pTable ? pTable->get_offset(prop_name) : NULL;
+	if( !pField || pField->type != FIELD_EHANDLE )
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Property is not a handle array.")
+
+	int* pHandles = (int *) (pBase + pField->offset);
+	for( int i = 0; i < pField->count; i++ )
+	{
+		indexes.append(ResolveIntHandle(pHandles[i]));
+	}
+
+	return indexes;
+}
@@ -0,0 +1,47 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _ENTITIES_HANDLES_H
+#define _ENTITIES_HANDLES_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "edict.h"
+#include "utility/wrap_macros.h"
+
+//---------------------------------------------------------------------------------
+// Resolves a buffer or sequence of int handles to entity indexes. Stale handles
+// are returned as -1.
+//---------------------------------------------------------------------------------
+list indexes_from_inthandles( object handles );
+
+//---------------------------------------------------------------------------------
+// Resolves all handles of a handle array (send prop or datamap field) of the
+// given edict to entity indexes. Stale handles are returned as -1.
+//---------------------------------------------------------------------------------
+list UTIL_IndexesOfHandleArray( edict_t* pEdict, const char* prop_name );
+
+#endif // _ENTITIES_HANDLES_H
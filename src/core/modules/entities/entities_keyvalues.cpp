@@ -0,0 +1,199 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <stdio.h>
+#include "entities_keyvalues.h"
+#include "entities_datamaps.h"
+#include "toolframework/itoolentity.h"
+#include "modules/vecmath/vecmath_wrap.h"
+
+//---------------------------------------------------------------------------------
+// External variables.
+//---------------------------------------------------------------------------------
+extern IServerTools* servertools;
+
+//---------------------------------------------------------------------------------
+// Maximum length of a keyvalue read from an entity.
+//---------------------------------------------------------------------------------
+#define MAX_KEYVALUE_LENGTH 1024
+
+//---------------------------------------------------------------------------------
+// Helper functions.
+//---------------------------------------------------------------------------------
+static CBaseEntity* GetKeyValueEntity( edict_t* pEdict )
+{
+	if( !servertools )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "IServerTools is not available.")
+
+	if( !pEdict || pEdict->IsFree() || !pEdict->GetUnknown() )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Entity is not valid.")
+
+	return pEdict->GetUnknown()->GetBaseEntity();
+}
+
+static const CDataMapOffset* GetKeyField( edict_t* pEdict, const char* key_name )
+{
+	CDataMapTable* pTable = UTIL_GetDataMapTable(pEdict);
+	if( !pTable )
+		return NULL;
+
+	return pTable->get_key(key_name);
+}
+
+static bool ExtractVector( object value, Vector& vecValue )
+{
+	extract<CVector *> vector(value);
+	if( vector.check() )
+	{
+		vecValue = *vector();
+		return true;
+	}
+
+	if( PyUnicode_Check(value.ptr()) || !PySequence_Check(value.ptr()) || len(value) != 3 )
+		return false;
+
+	vecValue.Init(extract<float>(value[0]), extract<float>(value[1]), extract<float>(value[2]));
+	return true;
+}
+
+static void SetKeyValue( CBaseEntity* pEntity, edict_t* pEdict, const char* key_name, object value )
+{
+	const CDataMapOffset* pField = GetKeyField(pEdict, key_name);
+	fieldtype_t type = pField ? pField->type : FIELD_VOID;
+
+	switch( type )
+	{
+	case FIELD_FLOAT:
+	case FIELD_TIME:
+		servertools->SetKeyValue(pEntity, key_name, extract<float>(value));
+		break;
+
+	case FIELD_INTEGER:
+	case FIELD_SHORT:
+	case FIELD_CHARACTER:
+	case FIELD_BOOLEAN:
+	case FIELD_COLOR32:
+	case FIELD_TICK:
+	case FIELD_MODELINDEX:
+	{
+		// Colors are given as "r g b a", so only numbers are converted.
+		extract<int> iValue(value);
+		if( iValue.check() && type != FIELD_COLOR32 )
+		{
+			char szValue[16];
+			Q_snprintf(szValue, sizeof(szValue), "%d", iValue());
+			servertools->SetKeyValue(pEntity, key_name, szValue);
+		}
+		else
+			servertools->SetKeyValue(pEntity, key_name, extract<const char*>(str(value)));
+		break;
+	}
+
+	default:
+	{
+		// Unknown keys and vectors use the type of the given value.
+		Vector vecValue;
+		if( PyFloat_Check(value.ptr()) )
+			servertools->SetKeyValue(pEntity, key_name, (float) extract<float>(value));
+		else if( PyBool_Check(value.ptr()) )
+			servertools->SetKeyValue(pEntity, key_name, value.ptr() == Py_True ? "1" : "0");
+		else if( ExtractVector(value, vecValue) )
+			servertools->SetKeyValue(pEntity, key_name, vecValue);
+		else
+			servertools->SetKeyValue(pEntity, key_name, extract<const char*>(str(value)));
+		break;
+	}
+	}
+
+	if( pField )
+		pEdict->StateChanged(pField->offset);
+}
+
+//---------------------------------------------------------------------------------
+// Exposed functions.
+//---------------------------------------------------------------------------------
+object UTIL_GetKeyValue( edict_t* pEdict, const char* key_name )
+{
+	CBaseEntity* pEntity = GetKeyValueEntity(pEdict);
+
+	char szValue[MAX_KEYVALUE_LENGTH];
+	if( !servertools->GetKeyValue(pEntity, key_name, szValue, sizeof(szValue)) )
+		BOOST_RAISE_EXCEPTION(PyExc_KeyError, "Entity has no such keyvalue.")
+
+	const CDataMapOffset* pField = GetKeyField(pEdict, key_name);
+	if( !pField )
+		return str(szValue);
+
+	switch( pField->type )
+	{
+	case FIELD_FLOAT:
+	case FIELD_TIME:
+		return object(atof(szValue));
+
+	case FIELD_INTEGER:
+	case FIELD_SHORT:
+	case FIELD_CHARACTER:
+	case FIELD_TICK:
+	case FIELD_MODELINDEX:
+		return object(atoi(szValue));
+
+	case FIELD_BOOLEAN:
+		return object(atoi(szValue) != 0);
+
+	case FIELD_VECTOR:
+	case FIELD_POSITION_VECTOR:
+	{
+		float x = 0, y = 0, z = 0;
+		sscanf(szValue, "%f %f %f", &x, &y, &z);
+		return object(CVector(x, y, z));
+	}
+
+	default:
+		return str(szValue);
+	}
+}
+
+void UTIL_SetKeyValue( edict_t* pEdict, const char* key_name, object value )
+{
+	CBaseEntity* pEntity = GetKeyValueEntity(pEdict);
+	SetKeyValue(pEntity, pEdict, key_name, value);
+}
+
+void UTIL_SetKeyValues( edict_t* pEdict, dict keyvalues )
+{
+	CBaseEntity* pEntity = GetKeyValueEntity(pEdict);
+
+	list items = keyvalues.items();
+	int iItems = len(items);
+	for( int i = 0; i < iItems; i++ )
+	{
+		const char* key_name = extract<const char*>(items[i][0]);
+		SetKeyValue(pEntity, pEdict, key_name, items[i][1]);
+	}
+}
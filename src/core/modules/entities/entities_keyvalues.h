@@ -0,0 +1,46 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _ENTITIES_KEYVALUES_H
+#define _ENTITIES_KEYVALUES_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "edict.h"
+#include "utility/wrap_macros.h"
+
+//---------------------------------------------------------------------------------
+// Keyvalue access through IServerTools. The type of a key is taken from the
+// entity's datamap (cached per class), so values are converted to and from the
+// matching Python type. Keys that aren't in the datamap are read as strings.
+//---------------------------------------------------------------------------------
+object	UTIL_GetKeyValue( edict_t* pEdict, const char* key_name );
+void	UTIL_SetKeyValue( edict_t* pEdict, const char* key_name, object value );
+
+// Sets all keyvalues of the given dict.
+void	UTIL_SetKeyValues( edict_t* pEdict, dict keyvalues );
+
+#endif // _ENTITIES_KEYVALUES_H
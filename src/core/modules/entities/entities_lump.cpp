@@ -0,0 +1,321 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <ctype.h>
+#include <stdlib.h>
+#include "entities_lump.h"
+#include "eiface.h"
+#include "tier1/strtools.h"
+#include "boost/algorithm/string.hpp"
+
+//---------------------------------------------------------------------------------
+// External variables.
+//---------------------------------------------------------------------------------
+extern IVEngineServer* engine;
+
+//---------------------------------------------------------------------------------
+// Static singletons.
+//---------------------------------------------------------------------------------
+static CMapEntityLump s_MapEntityLump;
+
+//---------------------------------------------------------------------------------
+// MapEntityLump accessor.
+//---------------------------------------------------------------------------------
+CMapEntityLump* get_map_entity_lump()
+{
+	return &s_MapEntityLump;
+}
+
+//---------------------------------------------------------------------------------
+// Reads the next token of the lump. Returns false at the end of the lump.
+//---------------------------------------------------------------------------------
+static bool ReadLumpToken( const char*& pos, std::string& token )
+{
+	while( *pos && isspace((unsigned char) *pos) )
+		pos++;
+
+	if( !*pos )
+		return false;
+
+	// Braces are single character tokens.
+	if( *pos == '{' || *pos == '}' )
+	{
+		token.assign(pos, 1);
+		pos++;
+		return true;
+	}
+
+	if( *pos == '"' )
+	{
+		const char* start = ++pos;
+		while( *pos && *pos != '"' )
+			pos++;
+
+		token.assign(start, pos - start);
+		if( *pos )
+			pos++;
+
+		return true;
+	}
+
+	const char* start = pos;
+	while( *pos && !isspace((unsigned char) *pos) && *pos != '{' && *pos != '}' && *pos != '"' )
+		pos++;
+
+	token.assign(start, pos - start);
+	return true;
+}
+
+//---------------------------------------------------------------------------------
+// CMapEntityBlock code.
+//---------------------------------------------------------------------------------
+CMapEntityBlock::CMapEntityBlock( int index )
+{
+	m_iIndex = index;
+}
+
+int CMapEntityBlock::get_index()
+{
+	return m_iIndex;
+}
+
+const char* CMapEntityBlock::get_classname()
+{
+	return get_value("classname");
+}
+
+const char* CMapEntityBlock::get_targetname()
+{
+	return get_value("targetname");
+}
+
+int CMapEntityBlock::get_hammer_id()
+{
+	const char* szHammerID = get_value("hammerid");
+	return szHammerID ? atoi(szHammerID) : 0;
+}
+
+const char* CMapEntityBlock::get_value( const char* key )
+{
+	for( unsigned int i = 0; i < m_KeyValues.size(); i++ )
+	{
+		if( Q_stricmp(m_KeyValues[i].first.c_str(), key) == 0 )
+			return m_KeyValues[i].second.c_str();
+	}
+
+	return NULL;
+}
+
+list CMapEntityBlock::get_values( const char* key )
+{
+	list values;
+	for( unsigned int i = 0; i < m_KeyValues.size(); i++ )
+	{
+		if( Q_stricmp(m_KeyValues[i].first.c_str(), key) == 0 )
+			values.append(m_KeyValues[i].second);
+	}
+
+	return values;
+}
+
+list CMapEntityBlock::get_keyvalues()
+{
+	list keyvalues;
+	for( unsigned int i = 0; i < m_KeyValues.size(); i++ )
+	{
+		keyvalues.append(make_tuple(m_KeyValues[i].first, m_KeyValues[i].second));
+	}
+
+	return keyvalues;
+}
+
+int CMapEntityBlock::get_count()
+{
+	return (int) m_KeyValues.size();
+}
+
+void CMapEntityBlock::add_keyvalue( const std::string& key, const std::string& value )
+{
+	m_KeyValues.push_back(std::make_pair(key, value));
+}
+
+//---------------------------------------------------------------------------------
+// CMapEntityLump code.
+//---------------------------------------------------------------------------------
+CMapEntityLump::CMapEntityLump()
+{
+	m_bParsed = false;
+}
+
+void CMapEntityLump::parse( const char* szEntities )
+{
+	clear();
+	m_bParsed = true;
+
+	if( !szEntities )
+		return;
+
+	const char* pos = szEntities;
+	std::string token;
+	std::string key;
+
+	while( ReadLumpToken(pos, token) )
+	{
+		if( token != "{" )
+		{
+			DevMsg(1, "[SP]: Unexpected token '%s' in the entity lump.\n", token.c_str());
+			break;
+		}
+
+		// The Python object owns the block.
+		int iIndex = (int) m_Blocks.size();
+		CMapEntityBlock* pBlock = new CMapEntityBlock(iIndex);
+		manage_new_object::apply<CMapEntityBlock *>::type convert;
+		m_BlockObjects.push_back(object(handle<>(convert(pBlock))));
+		m_Blocks.push_back(pBlock);
+		CMapEntityBlock& block = *pBlock;
+
+		// Read "key" "value" pairs until the block ends.
+		while( ReadLumpToken(pos, key) && key != "}" )
+		{
+			if( !ReadLumpToken(pos, token) )
+				break;
+
+			block.add_keyvalue(key, token);
+		}
+
+		const char* szClassName = block.get_classname();
+		if( szClassName )
+		{
+			std::string name = szClassName;
+			boost::algorithm::to_lower(name);
+			m_ClassNames[name].push_back(iIndex);
+		}
+
+		const char* szTargetName = block.get_targetname();
+		if( szTargetName )
+		{
+			std::string name = szTargetName;
+			boost::algorithm::to_lower(name);
+			m_TargetNames[name].push_back(iIndex);
+		}
+
+		int iHammerID = block.get_hammer_id();
+		if( iHammerID )
+			m_HammerIDs[iHammerID] = iIndex;
+	}
+}
+
+void CMapEntityLump::clear()
+{
+	m_bParsed = false;
+	m_Blocks.clear();
+	m_BlockObjects.clear();
+	m_ClassNames.clear();
+	m_TargetNames.clear();
+	m_HammerIDs.clear();
+}
+
+void CMapEntityLump::ensure_parsed()
+{
+	if( !m_bParsed )
+		parse(engine->GetMapEntitiesString());
+}
+
+int CMapEntityLump::get_count()
+{
+	ensure_parsed();
+	return (int) m_Blocks.size();
+}
+
+object CMapEntityLump::get_block( int index )
+{
+	ensure_parsed();
+	if( index < 0 || index >= (int) m_Blocks.size() )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid block index.")
+
+	return m_BlockObjects[index];
+}
+
+list CMapEntityLump::get_blocks( const boost::unordered_map<std::string, std::vector<int> >& index, const char* name )
+{
+	ensure_parsed();
+
+	list blocks;
+	std::string key = name;
+	boost::algorithm::to_lower(key);
+
+	boost::unordered_map<std::string, std::vector<int> >::const_iterator it = index.find(key);
+	if( it == index.end() )
+		return blocks;
+
+	for( unsigned int i = 0; i < it->second.size(); i++ )
+	{
+		blocks.append(m_BlockObjects[it->second[i]]);
+	}
+
+	return blocks;
+}
+
+list CMapEntityLump::find_by_classname( const char* classname )
+{
+	return get_blocks(m_ClassNames, classname);
+}
+
+list CMapEntityLump::find_by_targetname( const char* targetname )
+{
+	return get_blocks(m_TargetNames, targetname);
+}
+
+object CMapEntityLump::find_by_hammer_id( int hammer_id )
+{
+	ensure_parsed();
+
+	boost::unordered_map<int, int>::const_iterator it = m_HammerIDs.find(hammer_id);
+	if( it == m_HammerIDs.end() )
+		return object();
+
+	return m_BlockObjects[it->second];
+}
+
+list CMapEntityLump::find_by_keyvalue( const char* key, const char* value )
+{
+	ensure_parsed();
+
+	// Keys that aren't indexed require a full scan of the blocks.
+	list blocks;
+	for( unsigned int i = 0; i < m_Blocks.size(); i++ )
+	{
+		const char* szValue = m_Blocks[i]->get_value(key);
+		if( szValue && Q_stricmp(szValue, value) == 0 )
+			blocks.append(m_BlockObjects[i]);
+	}
+
+	return blocks;
+}
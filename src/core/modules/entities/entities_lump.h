@@ -0,0 +1,109 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _ENTITIES_LUMP_H
+#define _ENTITIES_LUMP_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include "boost/unordered_map.hpp"
+#include "utility/wrap_macros.h"
+
+//---------------------------------------------------------------------------------
+// A single entity block of the map's entity lump.
+//---------------------------------------------------------------------------------
+class CMapEntityBlock
+{
+public:
+	CMapEntityBlock( int index );
+
+	// Position of the block in the lump.
+	int				get_index();
+
+	const char*		get_classname();
+	const char*		get_targetname();
+	int				get_hammer_id();
+
+	// Returns the first value of the key (case insensitive) or None.
+	const char*		get_value( const char* key );
+
+	// Returns all values of the key (outputs can be given multiple times).
+	list			get_values( const char* key );
+
+	// Returns a list of (key, value) tuples in the order of the lump.
+	list			get_keyvalues();
+	int				get_count();
+
+	void			add_keyvalue( const std::string& key, const std::string& value );
+
+private:
+	int												m_iIndex;
+	std::vector< std::pair<std::string, std::string> >	m_KeyValues;
+};
+
+//---------------------------------------------------------------------------------
+// The map's entity lump. It's parsed once per map and indexed by classname,
+// targetname and hammer id, so scripts only get the blocks they ask for.
+// Every block is owned by a single Python object, which all queries return,
+// so lookups don't copy blocks and blocks outlive a map change safely.
+//---------------------------------------------------------------------------------
+class CMapEntityLump
+{
+public:
+	CMapEntityLump();
+
+	// Parses the lump of the current map.
+	void	parse( const char* szEntities );
+	void	clear();
+
+	int		get_count();
+	object	get_block( int index );
+
+	// Queries return lists of CMapEntityBlock instances.
+	list	find_by_classname( const char* classname );
+	list	find_by_targetname( const char* targetname );
+	object	find_by_hammer_id( int hammer_id );
+	list	find_by_keyvalue( const char* key, const char* value );
+
+private:
+	// Parses the lump of the current map if it wasn't parsed yet.
+	void	ensure_parsed();
+	list	get_blocks( const boost::unordered_map<std::string, std::vector<int> >& index, const char* name );
+
+private:
+	bool											m_bParsed;
+	std::vector<object>								m_BlockObjects;
+	std::vector<CMapEntityBlock*>					m_Blocks;
+	boost::unordered_map<std::string, std::vector<int> >	m_ClassNames;
+	boost::unordered_map<std::string, std::vector<int> >	m_TargetNames;
+	boost::unordered_map<int, int>					m_HammerIDs;
+};
+
+CMapEntityLump* get_map_entity_lump();
+
+#endif // _ENTITIES_LUMP_H
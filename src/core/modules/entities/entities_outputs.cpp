@@ -0,0 +1,335 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <algorithm>
+#include "entities_outputs.h"
+#include "entities_datamaps.h"
+#include "string_t.h"
+#include "cpp_manager.h"
+#include "modules/memory/memory_hooks.h"
+#include "utility/sp_util.h"
+#include "boost/algorithm/string.hpp"
+
+//---------------------------------------------------------------------------------
+// Static singletons.
+//---------------------------------------------------------------------------------
+static COutputListenerManager s_OutputListenerManager;
+
+//---------------------------------------------------------------------------------
+// OutputListenerManager accessor.
+//---------------------------------------------------------------------------------
+COutputListenerManager* get_output_listener_manager()
+{
+	return &s_OutputListenerManager;
+}
+
+//---------------------------------------------------------------------------------
+// void CBaseEntityOutput::FireOutput(variant_t, CBaseEntity*, CBaseEntity*, float)
+// The variant_t is passed by value and takes up five stack slots.
+//---------------------------------------------------------------------------------
+HookRetBuf_t* FireOutputPre( CDetour* pDetour )
+{
+	void* pOutput = *(void **) GetArgumentAddress(pDetour, 0);
+	void* pActivator = *(void **) GetArgumentAddress(pDetour, 6);
+	void* pCaller = *(void **) GetArgumentAddress(pDetour, 7);
+	float flDelay = *(float *) GetArgumentAddress(pDetour, 8);
+	s_OutputListenerManager.fire_output(pOutput, pActivator, pCaller, flDelay);
+
+	HookRetBuf_t* buffer = new HookRetBuf_t;
+	buffer->eRes = HOOKRES_NONE;
+	buffer->pRetBuf = NULL;
+	return buffer;
+}
+
+//---------------------------------------------------------------------------------
+// Returns the name of the output if it is a member of the given entity.
+//---------------------------------------------------------------------------------
+static const char* GetOutputName( edict_t* pEdict, void* pOutput, CDataMapTable*& pTable )
+{
+	if( !pEdict || pEdict->IsFree() || !pEdict->GetUnknown() )
+		return NULL;
+
+	char* pEntity = (char *) pEdict->GetUnknown()->GetBaseEntity();
+	if( !pEntity || (char *) pOutput < pEntity )
+		return NULL;
+
+	pTable = UTIL_GetDataMapTable(pEdict);
+	if( !pTable )
+		return NULL;
+
+	return pTable->get_output_name((int) ((char *) pOutput - pEntity));
+}
+
+//---------------------------------------------------------------------------------
+// Returns the edict of the entity the output is a member of. That's usually the
+// caller, but outputs can also be fired with another caller or none at all. In
+// that case the owner is the entity with the closest address below the output.
+// Outputs of entities without an edict can't be resolved.
+//---------------------------------------------------------------------------------
+static edict_t* FindOutputOwner( void* pOutput, void* pCaller, const char*& szOutput, CDataMapTable*& pTable )
+{
+	edict_t* pEdict = EdictOfBaseEntity(pCaller);
+	szOutput = GetOutputName(pEdict, pOutput, pTable);
+	if( szOutput )
+		return pEdict;
+
+	edict_t* pOwner = NULL;
+	char* pClosest = NULL;
+	for( int i = 0; i < gpGlobals->maxEntities; i++ )
+	{
+		pEdict = PEntityOfEntIndex(i);
+		if( !pEdict || pEdict->IsFree() || !pEdict->GetUnknown() )
+			continue;
+
+		char* pEntity = (char *) pEdict->GetUnknown()->GetBaseEntity();
+		if( pEntity && pEntity <= (char *) pOutput && pEntity > pClosest )
+		{
+			pClosest = pEntity;
+			pOwner = pEdict;
+		}
+	}
+
+	szOutput = GetOutputName(pOwner, pOutput, pTable);
+	return szOutput ? pOwner : NULL;
+}
+
+//---------------------------------------------------------------------------------
+// COutputListenerManager code.
+//---------------------------------------------------------------------------------
+COutputListenerManager::COutputListenerManager()
+{
+	m_pFireOutput = NULL;
+	m_bHooked = false;
+	m_iNextID = 1;
+}
+
+void COutputListenerManager::set_fire_output_function( object pointer )
+{
+	// The detour can't be moved once it was created.
+	if( m_bHooked )
+		return;
+
+	m_pFireOutput = (void *) ExtractPyPtr(pointer);
+}
+
+bool COutputListenerManager::install_hook()
+{
+	if( m_bHooked )
+		return true;
+
+	if( !m_pFireOutput )
+		return false;
+
+	m_bHooked = CPP_CreateCallback(m_pFireOutput, CONV_THISCALL, "iiiiippf)v", &FireOutputPre, TYPE_PRE);
+	return m_bHooked;
+}
+
+int COutputListenerManager::register_listener( object callback, const char* output, const char* classname /* = "" */,
+	const char* targetname /* = "" */, bool batched /* = false */ )
+{
+	if( !PyCallable_Check(callback.ptr()) )
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Callback is not callable.")
+
+	if( !install_hook() )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Failed to hook FireOutput.")
+
+	int id = m_iNextID++;
+	OutputListener_t& listener = m_Listeners[id];
+	listener.callback = callback;
+	listener.output = output;
+	listener.classname = classname;
+	listener.targetname = targetname;
+	listener.batched = batched;
+	boost::algorithm::to_lower(listener.output);
+
+	m_OutputListeners[listener.output].push_back(id);
+	return id;
+}
+
+void COutputListenerManager::unregister_listener( int id )
+{
+	boost::unordered_map<int, OutputListener_t>::iterator it = m_Listeners.find(id);
+	if( it == m_Listeners.end() )
+		return;
+
+	std::vector<int>& ids = m_OutputListeners[it->second.output];
+	ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+	if( ids.empty() )
+		m_OutputListeners.erase(it->second.output);
+
+	m_Listeners.erase(it);
+}
+
+int COutputListenerManager::get_count()
+{
+	return (int) m_Listeners.size();
+}
+
+void COutputListenerManager::clear_events()
+{
+	for( unsigned int i = 0; i < m_PendingListeners.size(); i++ )
+	{
+		boost::unordered_map<int, OutputListener_t>::iterator it = m_Listeners.find(m_PendingListeners[i]);
+		if( it != m_Listeners.end() )
+			it->second.events = boost::python::list();
+	}
+
+	m_PendingListeners.clear();
+}
+
+void COutputListenerManager::clear()
+{
+	m_Listeners.clear();
+	m_OutputListeners.clear();
+	m_PendingListeners.clear();
+}
+
+void COutputListenerManager::process()
+{
+	if( m_PendingListeners.empty() )
+		return;
+
+	// Listeners may be (un)registered by the callbacks.
+	std::vector<int> pending;
+	pending.swap(m_PendingListeners);
+
+	for( unsigned int i = 0; i < pending.size(); i++ )
+	{
+		boost::unordered_map<int, OutputListener_t>::iterator it = m_Listeners.find(pending[i]);
+		if( it == m_Listeners.end() )
+			continue;
+
+		object callback = it->second.callback;
+		boost::python::list events = it->second.events;
+		it->second.events = boost::python::list();
+
+		BEGIN_BOOST_PY()
+
+			callback(events);
+
+		END_BOOST_PY_NORET()
+	}
+}
+
+void COutputListenerManager::fire_output( void* pOutput, void* pActivator, void* pCaller, float flDelay )
+{
+	// Most outputs are rejected here, before anything is looked up.
+	if( m_Listeners.empty() )
+		return;
+
+	// Outputs are members of the entity that fires them.
+	const char* szOutput;
+	CDataMapTable* pTable;
+	edict_t* pEdict = FindOutputOwner(pOutput, pCaller, szOutput, pTable);
+	if( !pEdict )
+		return;
+
+	std::string output = szOutput;
+	boost::algorithm::to_lower(output);
+
+	boost::unordered_map<std::string, std::vector<int> >::iterator namedIter = m_OutputListeners.find(output);
+	boost::unordered_map<std::string, std::vector<int> >::iterator anyIter = m_OutputListeners.find("");
+	if( namedIter == m_OutputListeners.end() && anyIter == m_OutputListeners.end() )
+		return;
+
+	std::vector<int> ids;
+	if( namedIter != m_OutputListeners.end() )
+		ids.insert(ids.end(), namedIter->second.begin(), namedIter->second.end());
+
+	if( anyIter != m_OutputListeners.end() )
+		ids.insert(ids.end(), anyIter->second.begin(), anyIter->second.end());
+
+	const char* szClassName = pEdict->GetClassName();
+	const char* szTargetName = NULL;
+
+	std::vector<int> matched;
+	for( unsigned int i = 0; i < ids.size(); i++ )
+	{
+		OutputListener_t& listener = m_Listeners[ids[i]];
+		if( !listener.classname.empty() && V_stricmp(listener.classname.c_str(), szClassName) != 0 )
+			continue;
+
+		if( !listener.targetname.empty() )
+		{
+			// Only read the targetname if a listener filters by it.
+			if( !szTargetName )
+			{
+				const CDataMapOffset* pName = pTable->get_offset("m_iName");
+				char* pEntity = (char *) pEdict->GetUnknown()->GetBaseEntity();
+				szTargetName = pName ? STRING(*(string_t *) (pEntity + pName->offset)) : NULL;
+				if( !szTargetName )
+					szTargetName = "";
+			}
+
+			if( V_stricmp(listener.targetname.c_str(), szTargetName) != 0 )
+				continue;
+		}
+
+		matched.push_back(ids[i]);
+	}
+
+	if( matched.empty() )
+		return;
+
+	edict_t* pActivatorEdict = EdictOfBaseEntity(pActivator);
+	edict_t* pCallerEdict = EdictOfBaseEntity(pCaller);
+	boost::python::tuple event = boost::python::make_tuple(
+		szOutput,
+		pActivatorEdict ? IndexOfEdict(pActivatorEdict) : -1,
+		pCallerEdict ? IndexOfEdict(pCallerEdict) : -1,
+		flDelay,
+		IndexOfEdict(pEdict)
+	);
+
+	std::vector<object> callbacks;
+	for( unsigned int i = 0; i < matched.size(); i++ )
+	{
+		OutputListener_t& listener = m_Listeners[matched[i]];
+		if( !listener.batched )
+		{
+			callbacks.push_back(listener.callback);
+			continue;
+		}
+
+		if( len(listener.events) == 0 )
+			m_PendingListeners.push_back(matched[i]);
+
+		listener.events.append(event);
+	}
+
+	// Called last, because the callbacks may unregister listeners.
+	for( unsigned int i = 0; i < callbacks.size(); i++ )
+	{
+		BEGIN_BOOST_PY()
+
+			object result(handle<>(PyObject_CallObject(callbacks[i].ptr(), event.ptr())));
+
+		END_BOOST_PY_NORET()
+	}
+}
@@ -0,0 +1,105 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _ENTITIES_OUTPUTS_H
+#define _ENTITIES_OUTPUTS_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include "edict.h"
+#include "boost/unordered_map.hpp"
+#include "utility/wrap_macros.h"
+
+//---------------------------------------------------------------------------------
+// Native entity output listeners. CBaseEntityOutput::FireOutput is detoured the
+// first time a listener is registered. Every fired output is matched against
+// the registered (output, classname, targetname) filters in C++, so Python is
+// only called for outputs somebody listens to. Batched listeners receive all
+// of their events of a frame in one call. The FireOutput signature is only
+// known for Linux, so listeners can't be registered on Windows servers.
+//---------------------------------------------------------------------------------
+class COutputListenerManager
+{
+public:
+	COutputListenerManager();
+
+	// Sets the address of CBaseEntityOutput::FireOutput.
+	void	set_fire_output_function( object pointer );
+
+	// Calls callback(output, activator_index, caller_index, delay, owner_index)
+	// whenever a matching output is fired. The owner is the entity the output
+	// belongs to, which the classname and targetname filters are matched
+	// against. Empty filters match everything. Batched listeners are called
+	// once per frame with a list of those tuples instead.
+	int		register_listener( object callback, const char* output, const char* classname = "",
+				const char* targetname = "", bool batched = false );
+
+	void	unregister_listener( int id );
+	int		get_count();
+
+	// Drops the pending events of batched listeners.
+	void	clear_events();
+
+	// Drops all listeners and pending events.
+	void	clear();
+
+	// Called once per frame to deliver batched events.
+	void	process();
+
+	// Called by the FireOutput hook.
+	void	fire_output( void* pOutput, void* pActivator, void* pCaller, float flDelay );
+
+private:
+	struct OutputListener_t
+	{
+		object				callback;
+		std::string			output;
+		std::string			classname;
+		std::string			targetname;
+		bool				batched;
+		boost::python::list	events;
+	};
+
+	bool	install_hook();
+
+private:
+	void*											m_pFireOutput;
+	bool											m_bHooked;
+	int												m_iNextID;
+	boost::unordered_map<int, OutputListener_t>		m_Listeners;
+
+	// Listener ids by lower case output name. The empty name matches all outputs.
+	boost::unordered_map<std::string, std::vector<int> >	m_OutputListeners;
+
+	// Ids of batched listeners that have pending events.
+	std::vector<int>								m_PendingListeners;
+};
+
+COutputListenerManager* get_output_listener_manager();
+
+#endif // _ENTITIES_OUTPUTS_H
@@ -67,6 +67,33 @@ SendProp* UTIL_FindSendProp( SendTable* send_table, const char* prop_name, int &
 	return NULL;
 }
 
+//---------------------------------------------------------------------------------
+// Returns true if a prop of the send table (or one of its data tables) is stored
+// at the given offset.
+//---------------------------------------------------------------------------------
+bool UTIL_IsSendPropOffset( SendTable* send_table, int offset, int iBaseOffset )
+{
+	int prop_count = send_table->GetNumProps();
+	for( int i = 0; i < prop_count; i++ )
+	{
+		SendProp* prop = send_table->GetProp(i);
+
+		// Excluded props only name a prop of another table.
+		if( prop->IsExcludeProp() )
+			continue;
+
+		// Data tables are stored relative to their own offset.
+		if( prop->GetDataTable() )
+		{
+			if( UTIL_IsSendPropOffset(prop->GetDataTable(), offset, iBaseOffset + prop->GetOffset()) )
+				return true;
+		}
+		else if( iBaseOffset + prop->GetOffset() == offset )
+			return true;
+	}
+	return false;
+}
+
 //----------------------------------------------------------------------------------
 // CSendPropHashtable code.
 //----------------------------------------------------------------------------------
@@ -31,6 +31,7 @@
 //---------------------------------------------------------------------------------
 #include "utlhash.h"
 #include "dt_send.h"
+#include "edict.h"
 
 //---------------------------------------------------------------------------------
 // Every SendProp has a name and an offset. We'll use this for the prop offset
@@ -83,5 +84,7 @@ public:
 // Helper functions
 //---------------------------------------------------------------------------------
 SendProp* UTIL_FindSendProp( SendTable* send_table, const char* prop_name, int &iOffset );
+SendProp* UTIL_GetSendProp( edict_t* edict, const char* prop_name, int &iOffset );
+bool UTIL_IsSendPropOffset( SendTable* send_table, int offset, int iBaseOffset = 0 );
 
 #endif // _ENTITIES_PROPS_H
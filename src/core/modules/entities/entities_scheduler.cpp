@@ -0,0 +1,237 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <algorithm>
+#include <math.h>
+#include "entities_scheduler.h"
+#include "utility/sp_util.h"
+
+//---------------------------------------------------------------------------------
+// Static singletons.
+//---------------------------------------------------------------------------------
+static CEntityScheduler s_EntityScheduler;
+
+//---------------------------------------------------------------------------------
+// EntityScheduler accessor.
+//---------------------------------------------------------------------------------
+CEntityScheduler* get_entity_scheduler()
+{
+	return &s_EntityScheduler;
+}
+
+//---------------------------------------------------------------------------------
+// Removes a value from a vector without keeping the order.
+//---------------------------------------------------------------------------------
+static void FastRemove( std::vector<int>& vec, int value )
+{
+	std::vector<int>::iterator it = std::find(vec.begin(), vec.end(), value);
+	if( it == vec.end() )
+		return;
+
+	*it = vec.back();
+	vec.pop_back();
+}
+
+//---------------------------------------------------------------------------------
+// CEntityScheduler code.
+//---------------------------------------------------------------------------------
+CEntityScheduler::CEntityScheduler()
+{
+	m_iNextID = 1;
+	m_iLastTick = -1;
+}
+
+int CEntityScheduler::schedule( int index, float delay, object callback, float interval /* = 0 */, boost::python::tuple args /* = tuple() */ )
+{
+	if( index < 0 || index >= MAX_EDICTS )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid entity index.")
+
+	edict_t* pEdict = PEntityOfEntIndex(index);
+	if( !pEdict || pEdict->IsFree() || !pEdict->GetUnknown() )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Entity is not valid.")
+
+	if( !PyCallable_Check(callback.ptr()) )
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Callback is not callable.")
+
+	if( m_iLastTick == -1 )
+		m_iLastTick = gpGlobals->tickcount;
+
+	int id = m_iNextID++;
+	ScheduleEntry_t& entry = m_Entries[id];
+	entry.iIndex = index;
+	entry.iHandle = pEdict->GetUnknown()->GetRefEHandle().ToInt();
+	entry.iIntervalTicks = interval > 0 ? ticks_of(interval) : 0;
+	entry.callback = callback;
+	entry.args = args;
+
+	// Entries are never due in the tick that was already processed.
+	insert(id, std::max(gpGlobals->tickcount, m_iLastTick) + ticks_of(delay));
+	m_EntityEntries[index].push_back(id);
+	return id;
+}
+
+void CEntityScheduler::cancel( int id )
+{
+	remove_entry(id);
+}
+
+void CEntityScheduler::cancel_all( int index )
+{
+	if( index < 0 || index >= MAX_EDICTS )
+		return;
+
+	// remove_entry() modifies the entity's vector.
+	std::vector<int> ids = m_EntityEntries[index];
+	for( unsigned int i = 0; i < ids.size(); i++ )
+	{
+		remove_entry(ids[i]);
+	}
+}
+
+bool CEntityScheduler::is_scheduled( int id )
+{
+	return m_Entries.find(id) != m_Entries.end();
+}
+
+int CEntityScheduler::get_count()
+{
+	return (int) m_Entries.size();
+}
+
+void CEntityScheduler::clear()
+{
+	m_Entries.clear();
+	for( int i = 0; i < SCHEDULER_WHEEL_SIZE; i++ )
+	{
+		m_Wheel[i].clear();
+	}
+
+	for( int i = 0; i < MAX_EDICTS; i++ )
+	{
+		m_EntityEntries[i].clear();
+	}
+
+	m_iLastTick = -1;
+}
+
+void CEntityScheduler::process()
+{
+	if( m_Entries.empty() )
+	{
+		m_iLastTick = gpGlobals->tickcount;
+		return;
+	}
+
+	int iTick = gpGlobals->tickcount;
+	if( m_iLastTick == -1 || iTick < m_iLastTick )
+		m_iLastTick = iTick - 1;
+
+	// Visit each slot at most once, even if many ticks passed.
+	int iFirstTick = m_iLastTick + 1;
+	if( iTick - iFirstTick >= SCHEDULER_WHEEL_SIZE )
+		iFirstTick = iTick - SCHEDULER_WHEEL_SIZE + 1;
+
+	m_iLastTick = iTick;
+
+	// Collect all due entries first, so callbacks can safely (re)schedule.
+	std::vector<int> due;
+	for( int t = iFirstTick; t <= iTick; t++ )
+	{
+		std::vector<int>& slot = m_Wheel[t % SCHEDULER_WHEEL_SIZE];
+		for( unsigned int i = 0; i < slot.size(); )
+		{
+			ScheduleEntry_t& entry = m_Entries[slot[i]];
+			if( entry.iDueTick > iTick )
+			{
+				i++;
+				continue;
+			}
+
+			due.push_back(slot[i]);
+			slot[i] = slot.back();
+			slot.pop_back();
+		}
+	}
+
+	for( unsigned int i = 0; i < due.size(); i++ )
+	{
+		int id = due[i];
+		boost::unordered_map<int, ScheduleEntry_t>::iterator it = m_Entries.find(id);
+
+		// Cancelled by an earlier callback of this batch.
+		if( it == m_Entries.end() )
+			continue;
+
+		// The entity is gone or the slot was reused. Only drop this entry,
+		// entries of a new entity in the same slot must still run.
+		if( ResolveIntHandle(it->second.iHandle) != it->second.iIndex )
+		{
+			remove_entry(id);
+			continue;
+		}
+
+		// Keep the callback alive, the entry may be removed while it runs.
+		object callback = it->second.callback;
+		boost::python::tuple args(make_tuple(it->second.iIndex) + it->second.args);
+
+		if( it->second.iIntervalTicks > 0 )
+			insert(id, iTick + it->second.iIntervalTicks);
+		else
+			remove_entry(id);
+
+		BEGIN_BOOST_PY()
+
+			object result(handle<>(PyObject_CallObject(callback.ptr(), args.ptr())));
+
+		END_BOOST_PY_NORET()
+	}
+}
+
+void CEntityScheduler::insert( int id, int iDueTick )
+{
+	m_Entries[id].iDueTick = iDueTick;
+	m_Wheel[iDueTick % SCHEDULER_WHEEL_SIZE].push_back(id);
+}
+
+void CEntityScheduler::remove_entry( int id )
+{
+	boost::unordered_map<int, ScheduleEntry_t>::iterator it = m_Entries.find(id);
+	if( it == m_Entries.end() )
+		return;
+
+	FastRemove(m_Wheel[it->second.iDueTick % SCHEDULER_WHEEL_SIZE], id);
+	FastRemove(m_EntityEntries[it->second.iIndex], id);
+	m_Entries.erase(it);
+}
+
+int CEntityScheduler::ticks_of( float seconds )
+{
+	int iTicks = (int) ceil(seconds / gpGlobals->interval_per_tick);
+	return iTicks < 1 ? 1 : iTicks;
+}
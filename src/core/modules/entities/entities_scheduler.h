@@ -0,0 +1,98 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _ENTITIES_SCHEDULER_H
+#define _ENTITIES_SCHEDULER_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <vector>
+#include "edict.h"
+#include "boost/unordered_map.hpp"
+#include "utility/wrap_macros.h"
+
+//---------------------------------------------------------------------------------
+// Number of ticks covered by one turn of the timing wheel.
+//---------------------------------------------------------------------------------
+#define SCHEDULER_WHEEL_SIZE 256
+
+//---------------------------------------------------------------------------------
+// Calls Python callbacks for entities after a delay, optionally repeating.
+// Entries are stored in a timing wheel keyed by server tick and bound to the
+// entity's handle. They are dropped when the edict is freed or reused, so no
+// callback is ever called for a stale index. All callbacks that are due in a
+// frame are called in one batch.
+//---------------------------------------------------------------------------------
+class CEntityScheduler
+{
+public:
+	CEntityScheduler();
+
+	// Calls callback(index, *args) after delay seconds and then every interval
+	// seconds (0 means once). Returns the id of the entry.
+	int		schedule( int index, float delay, object callback, float interval = 0, boost::python::tuple args = boost::python::tuple() );
+
+	void	cancel( int id );
+	void	cancel_all( int index );
+	bool	is_scheduled( int id );
+	int		get_count();
+
+	// Drops all entries.
+	void	clear();
+
+	// Called once per frame.
+	void	process();
+
+private:
+	struct ScheduleEntry_t
+	{
+		int		iIndex;
+		int		iHandle;
+		int		iDueTick;
+		int		iIntervalTicks;
+		object	callback;
+		boost::python::tuple	args;
+	};
+
+	void	insert( int id, int iDueTick );
+	void	remove_entry( int id );
+	int		ticks_of( float seconds );
+
+private:
+	int											m_iNextID;
+	int											m_iLastTick;
+	boost::unordered_map<int, ScheduleEntry_t>	m_Entries;
+
+	// Entry ids per wheel slot. Entries due in a later turn stay in their slot.
+	std::vector<int>							m_Wheel[SCHEDULER_WHEEL_SIZE];
+
+	// Entry ids per entity, so all entries of an entity can be dropped at once.
+	std::vector<int>							m_EntityEntries[MAX_EDICTS];
+};
+
+CEntityScheduler* get_entity_scheduler();
+
+#endif // _ENTITIES_SCHEDULER_H
@@ -0,0 +1,331 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "entities_spawn.h"
+#include "eiface.h"
+#include "iserverunknown.h"
+#include "iservernetworkable.h"
+#include "toolframework/itoolentity.h"
+#include "modules/vecmath/vecmath_wrap.h"
+#include "utility/call_python.h"
+#include "utility/sp_util.h"
+
+//---------------------------------------------------------------------------------
+// External variables.
+//---------------------------------------------------------------------------------
+extern IServerTools* servertools;
+
+//---------------------------------------------------------------------------------
+// Default number of operations per frame.
+//---------------------------------------------------------------------------------
+#define DEFAULT_SPAWN_BUDGET 16
+
+#if( SOURCE_ENGINE >= 3 )
+//---------------------------------------------------------------------------------
+// IServerTools of CS:GO can only remove entities by their hammer id. Entities
+// that weren't placed by the map get an id from this range first.
+//---------------------------------------------------------------------------------
+#define SPAWN_QUEUE_HAMMER_ID_BASE 0x40000000
+static int s_iNextHammerID = SPAWN_QUEUE_HAMMER_ID_BASE;
+#endif
+
+//---------------------------------------------------------------------------------
+// Static singletons.
+//---------------------------------------------------------------------------------
+static CEntitySpawnQueue s_EntitySpawnQueue;
+
+//---------------------------------------------------------------------------------
+// EntitySpawnQueue accessor.
+//---------------------------------------------------------------------------------
+CEntitySpawnQueue* get_entity_spawn_queue()
+{
+	return &s_EntitySpawnQueue;
+}
+
+//---------------------------------------------------------------------------------
+// CEntitySpawnQueue code.
+//---------------------------------------------------------------------------------
+CEntitySpawnQueue::CEntitySpawnQueue()
+{
+	m_iBudget = DEFAULT_SPAWN_BUDGET;
+	m_iNextBatch = 1;
+}
+
+int CEntitySpawnQueue::spawn_batch( object descriptors, PyObject* pCallable )
+{
+	if( !servertools )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "IServerTools is not available.")
+
+	// Convert everything first, so an invalid descriptor doesn't leave half a
+	// batch in the queue.
+	std::vector<SpawnRequest_t> requests;
+	int iBatch = m_iNextBatch;
+
+	stl_input_iterator<object> iter(descriptors), end;
+	for( ; iter != end; ++iter )
+	{
+		object descriptor = *iter;
+		int iLength = len(descriptor);
+		if( iLength < 1 || iLength > 3 )
+			BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Descriptors must be (classname[, keyvalues[, origin]]).")
+
+		SpawnRequest_t request;
+		request.classname = extract<std::string>(descriptor[0]);
+		request.bHasOrigin = false;
+		request.iBatch = iBatch;
+		request.iPosition = (int) requests.size();
+
+		object keyvalues = iLength > 1 ? object(descriptor[1]) : object();
+		if( !keyvalues.is_none() )
+		{
+			list items = extract<dict>(keyvalues)().items();
+			int iItems = len(items);
+			for( int i = 0; i < iItems; i++ )
+			{
+				std::string key = extract<std::string>(str(items[i][0]));
+				std::string value = extract<std::string>(str(items[i][1]));
+				request.keyvalues.push_back(std::make_pair(key, value));
+			}
+		}
+
+		object origin = iLength > 2 ? object(descriptor[2]) : object();
+		if( !origin.is_none() )
+		{
+			extract<CVector *> vector(origin);
+			if( vector.check() )
+			{
+				request.vecOrigin = *vector();
+			}
+			else
+			{
+				request.vecOrigin.Init(
+					extract<float>(origin[0]),
+					extract<float>(origin[1]),
+					extract<float>(origin[2]));
+			}
+			request.bHasOrigin = true;
+		}
+
+		requests.push_back(request);
+	}
+
+	m_iNextBatch++;
+
+	SpawnBatch_t& batch = m_Batches[iBatch];
+	if( pCallable && pCallable != Py_None )
+		batch.callback = object(handle<>(borrowed(pCallable)));
+
+	batch.indexes.assign(requests.size(), -1);
+	batch.iRemaining = (int) requests.size();
+
+	m_Spawns.insert(m_Spawns.end(), requests.begin(), requests.end());
+
+	// Empty batches are reported with the next frame.
+	return iBatch;
+}
+
+void CEntitySpawnQueue::remove_batch( object indexes )
+{
+	if( !servertools )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "IServerTools is not available.")
+
+	// Collect everything first, so an invalid index doesn't leave half a
+	// batch in the queue. Removals are stored as handles, so a reused edict
+	// is never removed.
+	std::vector<int> handles;
+	stl_input_iterator<int> iter(indexes), end;
+	for( ; iter != end; ++iter )
+	{
+		int iIndex = *iter;
+
+		// Never remove the world or players.
+		if( iIndex <= gpGlobals->maxClients || iIndex >= MAX_EDICTS )
+			BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid entity index.")
+
+		edict_t* pEdict = PEntityOfEntIndex(iIndex);
+		if( !pEdict || pEdict->IsFree() || !pEdict->GetUnknown() )
+			continue;
+
+		handles.push_back(pEdict->GetUnknown()->GetRefEHandle().ToInt());
+	}
+
+	m_Removals.insert(m_Removals.end(), handles.begin(), handles.end());
+}
+
+void CEntitySpawnQueue::set_budget( int budget )
+{
+	m_iBudget = budget < 0 ? 0 : budget;
+}
+
+int CEntitySpawnQueue::get_budget()
+{
+	return m_iBudget;
+}
+
+int CEntitySpawnQueue::get_pending_spawns()
+{
+	return (int) m_Spawns.size();
+}
+
+int CEntitySpawnQueue::get_pending_removals()
+{
+	return (int) m_Removals.size();
+}
+
+void CEntitySpawnQueue::clear()
+{
+	m_Spawns.clear();
+	m_Removals.clear();
+	m_Batches.clear();
+}
+
+void CEntitySpawnQueue::process()
+{
+	if( m_Batches.empty() && m_Removals.empty() )
+		return;
+
+	int iOperations = 0;
+	while( !m_Removals.empty() && (m_iBudget == 0 || iOperations < m_iBudget) )
+	{
+		int iHandle = m_Removals.front();
+		m_Removals.pop_front();
+		remove_entity(iHandle);
+		iOperations++;
+	}
+
+	while( !m_Spawns.empty() && (m_iBudget == 0 || iOperations < m_iBudget) )
+	{
+		SpawnRequest_t request = m_Spawns.front();
+		m_Spawns.pop_front();
+
+		std::map<int, SpawnBatch_t>::iterator it = m_Batches.find(request.iBatch);
+		int iIndex = spawn_entity(request);
+		iOperations++;
+
+		if( it == m_Batches.end() )
+			continue;
+
+		it->second.indexes[request.iPosition] = iIndex;
+		it->second.iRemaining--;
+	}
+
+	// Report finished batches. Callbacks may queue new batches, so the map is
+	// searched again after each call.
+	std::map<int, SpawnBatch_t>::iterator it = m_Batches.begin();
+	while( it != m_Batches.end() )
+	{
+		if( it->second.iRemaining > 0 )
+		{
+			++it;
+			continue;
+		}
+
+		int iBatch = it->first;
+		finish_batch(iBatch);
+		it = m_Batches.upper_bound(iBatch);
+	}
+}
+
+int CEntitySpawnQueue::spawn_entity( const SpawnRequest_t& request )
+{
+	CBaseEntity* pEntity = (CBaseEntity *) servertools->CreateEntityByName(request.classname.c_str());
+	if( !pEntity )
+		return -1;
+
+	for( unsigned int i = 0; i < request.keyvalues.size(); i++ )
+	{
+		servertools->SetKeyValue(pEntity, request.keyvalues[i].first.c_str(), request.keyvalues[i].second.c_str());
+	}
+
+	if( request.bHasOrigin )
+		servertools->SetKeyValue(pEntity, "origin", request.vecOrigin);
+
+	servertools->DispatchSpawn(pEntity);
+
+	edict_t* pEdict = EdictOfBaseEntity(pEntity);
+	if( !pEdict || pEdict->IsFree() )
+		return -1;
+
+	return IndexOfEdict(pEdict);
+}
+
+void CEntitySpawnQueue::remove_entity( int iHandle )
+{
+	int iIndex = ResolveIntHandle(iHandle);
+	if( iIndex == -1 )
+		return;
+
+	IServerUnknown* pUnknown = PEntityOfEntIndex(iIndex)->GetUnknown();
+	CBaseEntity* pEntity = pUnknown->GetBaseEntity();
+	if( !pEntity )
+		return;
+
+#if( SOURCE_ENGINE >= 3 )
+	char szHammerID[16];
+	int iHammerID = 0;
+	if( servertools->GetKeyValue(pEntity, "hammerid", szHammerID, sizeof(szHammerID)) )
+		iHammerID = atoi(szHammerID);
+
+	if( iHammerID == 0 )
+	{
+		iHammerID = s_iNextHammerID++;
+		Q_snprintf(szHammerID, sizeof(szHammerID), "%d", iHammerID);
+		servertools->SetKeyValue(pEntity, "hammerid", szHammerID);
+	}
+
+	servertools->RemoveEntity(iHammerID);
+#else
+	servertools->RemoveEntity(pEntity);
+#endif
+}
+
+void CEntitySpawnQueue::finish_batch( int iBatch )
+{
+	std::map<int, SpawnBatch_t>::iterator it = m_Batches.find(iBatch);
+	if( it == m_Batches.end() )
+		return;
+
+	object callback = it->second.callback;
+	list indexes;
+	for( unsigned int i = 0; i < it->second.indexes.size(); i++ )
+	{
+		indexes.append(it->second.indexes[i]);
+	}
+
+	m_Batches.erase(it);
+
+	if( callback.is_none() )
+		return;
+
+	BEGIN_BOOST_PY()
+
+		CALL_PY_FUNC(callback.ptr(), iBatch, indexes);
+
+	END_BOOST_PY_NORET()
+}
@@ -0,0 +1,102 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _ENTITIES_SPAWN_H
+#define _ENTITIES_SPAWN_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include "mathlib/vector.h"
+#include "utility/wrap_macros.h"
+
+//---------------------------------------------------------------------------------
+// Queues entity spawns and removals and executes them over multiple frames.
+// Every frame at most <budget> operations are processed, removals first. The
+// indexes of a spawn batch are passed to its callback once the whole batch has
+// been processed.
+//---------------------------------------------------------------------------------
+class CEntitySpawnQueue
+{
+public:
+	CEntitySpawnQueue();
+
+	// Queues a sequence of (classname[, keyvalues[, origin]]) descriptors.
+	// Returns the id of the batch.
+	int		spawn_batch( object descriptors, PyObject* pCallable );
+
+	// Queues the removal of a sequence of entity indexes.
+	void	remove_batch( object indexes );
+
+	// Maximum number of operations per frame (0 means no limit).
+	void	set_budget( int budget );
+	int		get_budget();
+
+	int		get_pending_spawns();
+	int		get_pending_removals();
+
+	// Drops all pending operations without calling any callbacks.
+	void	clear();
+
+	// Called once per frame.
+	void	process();
+
+private:
+	struct SpawnRequest_t
+	{
+		std::string		classname;
+		std::vector< std::pair<std::string, std::string> > keyvalues;
+		bool			bHasOrigin;
+		Vector			vecOrigin;
+		int				iBatch;
+		int				iPosition;
+	};
+
+	struct SpawnBatch_t
+	{
+		object				callback;
+		std::vector<int>	indexes;
+		int					iRemaining;
+	};
+
+	int		spawn_entity( const SpawnRequest_t& request );
+	void	remove_entity( int iHandle );
+	void	finish_batch( int iBatch );
+
+private:
+	int								m_iBudget;
+	int								m_iNextBatch;
+	std::deque<SpawnRequest_t>		m_Spawns;
+	std::deque<int>					m_Removals;
+	std::map<int, SpawnBatch_t>		m_Batches;
+};
+
+CEntitySpawnQueue* get_entity_spawn_queue();
+
+#endif // _ENTITIES_SPAWN_H
@@ -0,0 +1,270 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "entities_transmit.h"
+#include "eiface.h"
+#include "engine/ICollideable.h"
+#include "game/server/iplayerinfo.h"
+#include "cpp_manager.h"
+#include "modules/memory/memory_hooks.h"
+#include "utility/sp_util.h"
+#include "utility/wrap_macros.h"
+
+//---------------------------------------------------------------------------------
+// External variables.
+//---------------------------------------------------------------------------------
+extern IServerGameEnts* gameents;
+
+//---------------------------------------------------------------------------------
+// vtable index of IServerGameEnts::CheckTransmit (see eiface.h of the SDKs).
+// The linux offset is added in install_hook().
+//---------------------------------------------------------------------------------
+#if( SOURCE_ENGINE >= 3 )
+#	define CHECK_TRANSMIT_VTABLE_INDEX 5
+#else
+#	define CHECK_TRANSMIT_VTABLE_INDEX 6
+#endif
+
+//---------------------------------------------------------------------------------
+// Static singletons.
+//---------------------------------------------------------------------------------
+static CTransmitManager s_TransmitManager;
+
+//---------------------------------------------------------------------------------
+// TransmitManager accessor.
+//---------------------------------------------------------------------------------
+CTransmitManager* get_transmit_manager()
+{
+	return &s_TransmitManager;
+}
+
+//---------------------------------------------------------------------------------
+// void IServerGameEnts::CheckTransmit(CCheckTransmitInfo*, const unsigned short*, int)
+//---------------------------------------------------------------------------------
+HookRetBuf_t* CheckTransmitPost( CDetour* pDetour )
+{
+	CCheckTransmitInfo* pInfo = *(CCheckTransmitInfo **) GetArgumentAddress(pDetour, 1);
+	s_TransmitManager.check_transmit(pInfo);
+
+	HookRetBuf_t* buffer = new HookRetBuf_t;
+	buffer->eRes = HOOKRES_NONE;
+	buffer->pRetBuf = NULL;
+	return buffer;
+}
+
+//---------------------------------------------------------------------------------
+// CTransmitManager code.
+//---------------------------------------------------------------------------------
+CTransmitManager::CTransmitManager()
+{
+	m_bHooked = false;
+	for( int i = 0; i < MAX_EDICTS; i++ )
+	{
+		m_Rules[i].bActive = false;
+	}
+}
+
+bool CTransmitManager::install_hook()
+{
+	if( m_bHooked )
+		return true;
+
+	if( !gameents )
+		return false;
+
+	int iIndex = CHECK_TRANSMIT_VTABLE_INDEX;
+#ifdef __linux__
+	iIndex++;
+#endif
+
+	void** vtable = *(void ***) gameents;
+	m_bHooked = CPP_CreateCallback(vtable[iIndex], CONV_THISCALL, "ppi)v", &CheckTransmitPost, TYPE_POST);
+	return m_bHooked;
+}
+
+CTransmitManager::TransmitRule_t* CTransmitManager::get_rule( int entity_index )
+{
+	// Never hide the world.
+	if( entity_index <= 0 || entity_index >= MAX_EDICTS )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid entity index.")
+
+	edict_t* pEdict = PEntityOfEntIndex(entity_index);
+	if( !pEdict || pEdict->IsFree() )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Entity is not valid.")
+
+	if( !install_hook() )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Failed to hook CheckTransmit.")
+
+	TransmitRule_t* pRule = &m_Rules[entity_index];
+
+	// Rules of a freed and reused edict don't apply to the new entity.
+	if( pRule->bActive && pRule->iSerialNumber != pEdict->m_NetworkSerialNumber )
+		remove_rule(entity_index);
+
+	if( !pRule->bActive )
+	{
+		pRule->bActive = true;
+		pRule->iSerialNumber = pEdict->m_NetworkSerialNumber;
+		pRule->hidden.ClearAll();
+		pRule->iTeam = 0;
+		pRule->flMaxDistanceSqr = 0;
+		m_ActiveRules.AddToTail(entity_index);
+	}
+
+	return pRule;
+}
+
+void CTransmitManager::remove_rule( int entity_index )
+{
+	if( !m_Rules[entity_index].bActive )
+		return;
+
+	m_Rules[entity_index].bActive = false;
+	m_ActiveRules.FindAndRemove(entity_index);
+}
+
+void CTransmitManager::hide_entity( int entity_index, int player_index )
+{
+	if( player_index < 1 || player_index > ABSOLUTE_PLAYER_LIMIT )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index.")
+
+	get_rule(entity_index)->hidden.Set(player_index);
+}
+
+void CTransmitManager::show_entity( int entity_index, int player_index )
+{
+	if( player_index < 1 || player_index > ABSOLUTE_PLAYER_LIMIT )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index.")
+
+	get_rule(entity_index)->hidden.Clear(player_index);
+}
+
+void CTransmitManager::hide_entity_from_all( int entity_index )
+{
+	get_rule(entity_index)->hidden.SetAll();
+}
+
+bool CTransmitManager::is_entity_hidden( int entity_index, int player_index )
+{
+	if( entity_index <= 0 || entity_index >= MAX_EDICTS || player_index < 1 || player_index > ABSOLUTE_PLAYER_LIMIT )
+		return false;
+
+	const TransmitRule_t& rule = m_Rules[entity_index];
+	if( !rule.bActive || !rule.hidden.IsBitSet(player_index) )
+		return false;
+
+	// The rule belongs to the entity that was in the slot when it was added.
+	edict_t* pEdict = PEntityOfEntIndex(entity_index);
+	return pEdict && !pEdict->IsFree() && pEdict->m_NetworkSerialNumber == rule.iSerialNumber;
+}
+
+void CTransmitManager::set_team_only( int entity_index, int team )
+{
+	get_rule(entity_index)->iTeam = team;
+}
+
+void CTransmitManager::set_max_distance( int entity_index, float distance )
+{
+	get_rule(entity_index)->flMaxDistanceSqr = distance * distance;
+}
+
+void CTransmitManager::clear_rules( int entity_index )
+{
+	if( entity_index > 0 && entity_index < MAX_EDICTS )
+		remove_rule(entity_index);
+}
+
+void CTransmitManager::clear_all_rules()
+{
+	for( int i = 0; i < m_ActiveRules.Count(); i++ )
+	{
+		m_Rules[m_ActiveRules[i]].bActive = false;
+	}
+
+	m_ActiveRules.RemoveAll();
+}
+
+void CTransmitManager::clear_player( int player_index )
+{
+	if( player_index < 1 || player_index > ABSOLUTE_PLAYER_LIMIT )
+		return;
+
+	for( int i = 0; i < m_ActiveRules.Count(); i++ )
+	{
+		m_Rules[m_ActiveRules[i]].hidden.Clear(player_index);
+	}
+}
+
+void CTransmitManager::check_transmit( CCheckTransmitInfo* pInfo )
+{
+	if( !pInfo || !pInfo->m_pClientEnt || m_ActiveRules.Count() == 0 )
+		return;
+
+	int iPlayer = IndexOfEdict(pInfo->m_pClientEnt);
+	if( iPlayer < 1 || iPlayer > ABSOLUTE_PLAYER_LIMIT )
+		return;
+
+	// Only look up the player's team and origin once per snapshot.
+	IPlayerInfo* pPlayerInfo = playerinfomanager->GetPlayerInfo(pInfo->m_pClientEnt);
+	int iTeam = pPlayerInfo ? pPlayerInfo->GetTeamIndex() : 0;
+	Vector vecOrigin = pPlayerInfo ? pPlayerInfo->GetAbsOrigin() : vec3_origin;
+
+	// Walk backwards, so stale rules can be removed.
+	for( int i = m_ActiveRules.Count() - 1; i >= 0; i-- )
+	{
+		int iEntity = m_ActiveRules[i];
+
+		// Never hide the player from itself.
+		if( iEntity == iPlayer || !pInfo->m_pTransmitEdict->IsBitSet(iEntity) )
+			continue;
+
+		TransmitRule_t& rule = m_Rules[iEntity];
+		edict_t* pEdict = PEntityOfEntIndex(iEntity);
+		if( !pEdict || pEdict->IsFree() || pEdict->m_NetworkSerialNumber != rule.iSerialNumber )
+		{
+			rule.bActive = false;
+			m_ActiveRules.FastRemove(i);
+			continue;
+		}
+
+		bool bHide = rule.hidden.IsBitSet(iPlayer);
+		if( !bHide && rule.iTeam != 0 )
+			bHide = (rule.iTeam != iTeam);
+
+		if( !bHide && rule.flMaxDistanceSqr > 0 && pPlayerInfo )
+		{
+			ICollideable* pCollideable = pEdict->GetUnknown()->GetCollideable();
+			if( pCollideable )
+				bHide = (pCollideable->GetCollisionOrigin().DistToSqr(vecOrigin) > rule.flMaxDistanceSqr);
+		}
+
+		if( bHide )
+			pInfo->m_pTransmitEdict->Clear(iEntity);
+	}
+}
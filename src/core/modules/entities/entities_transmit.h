@@ -0,0 +1,99 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _ENTITIES_TRANSMIT_H
+#define _ENTITIES_TRANSMIT_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "edict.h"
+#include "const.h"
+#include "bitvec.h"
+#include "iservernetworkable.h"
+
+//---------------------------------------------------------------------------------
+// Player slot bits. Slot 0 is unused, so player indexes can be used directly.
+//---------------------------------------------------------------------------------
+typedef CBitVec<ABSOLUTE_PLAYER_LIMIT + 1> CTransmitPlayerBits;
+
+//---------------------------------------------------------------------------------
+// Native transmit rules. CheckTransmit is post-hooked the first time a rule is
+// added. The rules are evaluated in C++ for every client snapshot and clear the
+// transmit bits of the entities a player must not receive.
+//---------------------------------------------------------------------------------
+class CTransmitManager
+{
+public:
+	CTransmitManager();
+
+	// Per player rules.
+	void	hide_entity( int entity_index, int player_index );
+	void	show_entity( int entity_index, int player_index );
+	void	hide_entity_from_all( int entity_index );
+	bool	is_entity_hidden( int entity_index, int player_index );
+
+	// Only transmit the entity to players of the given team (0 disables it).
+	void	set_team_only( int entity_index, int team );
+
+	// Don't transmit the entity to players farther away (0 disables it).
+	void	set_max_distance( int entity_index, float distance );
+
+	// Removes all rules of an entity or of all entities.
+	void	clear_rules( int entity_index );
+	void	clear_all_rules();
+
+	// Clears the player's column of every rule.
+	void	clear_player( int player_index );
+
+	// Called by the CheckTransmit hook.
+	void	check_transmit( CCheckTransmitInfo* pInfo );
+
+private:
+	struct TransmitRule_t
+	{
+		bool					bActive;
+		short					iSerialNumber;
+		CTransmitPlayerBits		hidden;
+		int						iTeam;
+		float					flMaxDistanceSqr;
+	};
+
+	// Returns the rule of an entity and creates it if needed.
+	TransmitRule_t*	get_rule( int entity_index );
+	void			remove_rule( int entity_index );
+	bool			install_hook();
+
+private:
+	bool				m_bHooked;
+	TransmitRule_t		m_Rules[MAX_EDICTS];
+
+	// Entities with an active rule, so CheckTransmit only looks at those.
+	CUtlVector<int>		m_ActiveRules;
+};
+
+CTransmitManager* get_transmit_manager();
+
+#endif // _ENTITIES_TRANSMIT_H
@@ -29,6 +29,10 @@
 //-----------------------------------------------------------------------------
 #include <vector>
 #include "entities_props.h"
+#include "entities_datamaps.h"
+#include "entities_handles.h"
+#include "entities_keyvalues.h"
+#include "entities_cache.h"
 #include "entities_wrap.h"
 #include "dt_common.h"
 #include "utility/sp_util.h"
@@ -70,6 +74,7 @@ CEdict::CEdict( edict_t* edict_ptr )
 	m_edict_ptr = edict_ptr;
 	m_is_valid = (m_edict_ptr != NULL);
 	m_index = IndexOfEdict(m_edict_ptr);
+	m_serial_number = m_is_valid ? m_edict_ptr->m_NetworkSerialNumber : -1;
 }
 
 CEdict::CEdict( int index )
@@ -77,6 +82,7 @@ CEdict::CEdict( int index )
 	m_edict_ptr = PEntityOfEntIndex(index);
 	m_is_valid = (m_edict_ptr != NULL);
 	m_index = index;
+	m_serial_number = m_is_valid ? m_edict_ptr->m_NetworkSerialNumber : -1;
 }
 
 CEdict::CEdict( const char* name, bool bExact /* = true */ )
@@ -99,6 +105,7 @@ CEdict::CEdict( const char* name, bool bExact /* = true */ )
 				m_edict_ptr = edict;
 				m_is_valid = true;
 				m_index = i;
+				m_serial_number = edict->m_NetworkSerialNumber;
 				return;
 			}
 		}
@@ -110,6 +117,7 @@ CEdict::CEdict( const char* name, bool bExact /* = true */ )
 				m_edict_ptr = edict;
 				m_is_valid = true;
 				m_index = i;
+				m_serial_number = edict->m_NetworkSerialNumber;
 				return;
 			}
 		}
@@ -118,6 +126,7 @@ CEdict::CEdict( const char* name, bool bExact /* = true */ )
 	m_edict_ptr = NULL;
 	m_is_valid = false;
 	m_index = -1;
+	m_serial_number = -1;
 }
 
 int CEdict::area_num() const
@@ -181,11 +190,50 @@ CSendProp* CEdict::get_prop( const char* prop_name ) const
 	return new CSendProp(m_edict_ptr, prop_name);
 }
 
+CDataMapProp* CEdict::get_datamap( const char* field_name ) const
+{
+	return new CDataMapProp(m_edict_ptr, field_name);
+}
+
+list CEdict::get_handle_indexes( const char* prop_name ) const
+{
+	return UTIL_IndexesOfHandleArray(m_edict_ptr, prop_name);
+}
+
+object CEdict::get_keyvalue( const char* key_name ) const
+{
+	return UTIL_GetKeyValue(m_edict_ptr, key_name);
+}
+
+void CEdict::set_keyvalue( const char* key_name, object value )
+{
+	UTIL_SetKeyValue(m_edict_ptr, key_name, value);
+}
+
+void CEdict::set_keyvalues( dict keyvalues )
+{
+	UTIL_SetKeyValues(m_edict_ptr, keyvalues);
+}
+
 edict_t* CEdict::get_edict()
 {
 	return m_edict_ptr;
 }
 
+bool CEdict::operator==( object other ) const
+{
+	extract<CEdict *> other_edict(other);
+	if( !other_edict.check() )
+		return false;
+
+	return other_edict()->m_index == m_index && other_edict()->m_serial_number == m_serial_number;
+}
+
+bool CEdict::operator!=( object other ) const
+{
+	return !(*this == other);
+}
+
 //-----------------------------------------------------------------------------
 // CBaseEntityHandle code.
 //-----------------------------------------------------------------------------
@@ -233,11 +281,9 @@ CHandleEntity* CServerNetworkable::get_entity_handle()
 	return new_handle;
 }
 
-CEdict* CServerNetworkable::get_edict()
+object CServerNetworkable::get_edict()
 {
-	edict_t* edict = m_server_networkable->GetEdict();
-	CEdict* new_edict = new CEdict(edict);
-	return new_edict;
+	return g_EdictCache.get_edict(m_server_networkable->GetEdict());
 }
 
 const char* CServerNetworkable::get_class_name()
@@ -309,29 +355,13 @@ const char* CServerEntity::get_model_name()
 }
 
 //-----------------------------------------------------------------------------
-// CSendProp code.
+// Returns the SendProp of the given edict and its offset. The result is
+// cached per classname.
 //-----------------------------------------------------------------------------
-
-CSendProp::CSendProp( edict_t* edict, const char* prop_name )
+SendProp* UTIL_GetSendProp( edict_t* edict, const char* prop_name, int &iOffset )
 {
-	// Set default values.
-	m_send_prop = NULL;
-	m_prop_offset = 0;
-	m_edict = edict;
-
-	if( !m_edict )
-	{
-		DevMsg(1, "[SP]: edict was not valid!\n");
-		return;
-	}
-
-	// Get the base entity. This saves us from having to call
-	// this code repeatedly.
-	IServerUnknown* entity_unknown = m_edict->GetUnknown();
-	m_base_entity = entity_unknown->GetBaseEntity();
-
 	// Get the entity's classname
-	const char* szClassName = m_edict->GetClassName();
+	const char* szClassName = edict->GetClassName();
 
 	// Get the classname's prop table
 	SendPropMap::iterator sendPropIter = g_SendPropMap.find(szClassName);
@@ -344,74 +374,92 @@ CSendProp::CSendProp( edict_t* edict, const char* prop_name )
 		sendPropIter = g_SendPropMap.find(szClassName);
 	}
 
-	// Create an offset value to be set by the hash table
-	int iOffset = 0;
+	// Reset the offset value to be set by the hash table
+	iOffset = 0;
 
 	// Get the SendProp from the hash table
-	m_send_prop = sendPropIter->second->get_prop(prop_name, iOffset);
-
-	// Was the SendProp not found in the hash table?
-	if( !m_send_prop )
+	SendProp* cached_prop = sendPropIter->second->get_prop(prop_name, iOffset);
+	if( cached_prop )
 	{
+		// Prop was valid.
+		return cached_prop;
+	}
+
+	// Get the send table for this entity.
+	ServerClass* server_class = edict->GetNetworkable()->GetServerClass();
+	SendTable* send_table = server_class->m_pTable;
 
-		// Get the send table for this entity.
-		ServerClass* server_class = m_edict->GetNetworkable()->GetServerClass();
-		SendTable* send_table = server_class->m_pTable;
+	// Split the prop_name by "."
+	std::vector<std::string> tokens;
+	boost::algorithm::split(tokens, prop_name, boost::is_any_of("."));
 
-		// Split the prop_name by "."
-		std::vector<std::string> tokens;
-		boost::algorithm::split(tokens, prop_name, boost::is_any_of("."));
+	// Create base variables to use in the foreach loop
+	unsigned int i = 0;
+	SendProp* send_prop;
 
-		// Create base variables to use in the foreach loop
-		unsigned int i = 0;
-		SendProp* send_prop;
+	// Create a loop to cycle through each token in the given prop_name
+	BOOST_FOREACH(std::string token, tokens)
+	{
+		// Find the SendProp instance for the current token
+		const char* str_token = token.c_str();
+		send_prop = UTIL_FindSendProp(send_table, str_token, iOffset);
 
-		// Create a loop to cycle through each token in the given prop_name
-		BOOST_FOREACH(std::string token, tokens)
+		// Does the SendProp exist?
+		if( !send_prop )
 		{
-			// Find the SendProp instance for the current token
-			const char* str_token = token.c_str();
-			send_prop = UTIL_FindSendProp(send_table, str_token, iOffset);
+			// If not, exit
+			DevMsg(1, "[SP]: prop_name '%s' was not found!\n", prop_name);
+			return NULL;
+		}
+		// Increment the counter
+		i ++;
 
-			// Does the SendProp exist?
-			if( !send_prop )
+		// Is this the end of the loop?
+		if( i < tokens.size() )
+		{
+			// If not, is the current SendProp a datatable?
+			if( send_prop->GetType() != DPT_DataTable )
 			{
 				// If not, exit
 				DevMsg(1, "[SP]: prop_name '%s' was not found!\n", prop_name);
-				return;
+				return NULL;
 			}
-			// Increment the counter
-			i ++;
+			// Set the current datatable
+			send_table = send_prop->GetDataTable();
+		}
+	}
 
-			// Is this the end of the loop?
-			if( i < tokens.size() )
-			{
-				// If not, is the current SendProp a datatable?
-				if( send_prop->GetType() != DPT_DataTable )
-				{
-					// If not, exit
-					DevMsg(1, "[SP]: prop_name '%s' was not found!\n", prop_name);
-					return;
-				}
-				// Set the current datatable
-				send_table = send_prop->GetDataTable();
-			}
-			else
-			{
-				// Store the SendProp
-				m_send_prop = send_prop;
+	// Insert the prop into the hash table
+	sendPropIter->second->insert_offset(prop_name, send_prop, iOffset);
+	return send_prop;
+}
 
-				// Store the offset
-				m_prop_offset = iOffset;
+//-----------------------------------------------------------------------------
+// CSendProp code.
+//-----------------------------------------------------------------------------
+CSendProp::CSendProp( edict_t* edict, const char* prop_name )
+{
+	// Set default values.
+	m_send_prop = NULL;
+	m_prop_offset = 0;
+	m_edict = edict;
 
-				// Insert the prop into the hash table
-				sendPropIter->second->insert_offset(prop_name, m_send_prop, m_prop_offset);
-			}
-		}
+	if( !m_edict )
+	{
+		DevMsg(1, "[SP]: edict was not valid!\n");
+		return;
 	}
-	else
+
+	// Get the base entity. This saves us from having to call
+	// this code repeatedly.
+	IServerUnknown* entity_unknown = m_edict->GetUnknown();
+	m_base_entity = entity_unknown->GetBaseEntity();
+
+	// Find the prop and its offset.
+	int iOffset = 0;
+	m_send_prop = UTIL_GetSendProp(m_edict, prop_name, iOffset);
+	if( m_send_prop )
 	{
-		// Prop was valid. Store off the offset.
 		m_prop_offset = iOffset;
 	}
 }
@@ -433,8 +481,8 @@ void CSendProp::set_int( int value )
 		// Set the value.
 		*(int *)((char *)m_base_entity + m_prop_offset) = value;
 
-		// Force a network update.
-		m_edict->StateChanged();
+		// Mark only this prop as changed.
+		m_edict->StateChanged(m_prop_offset);
 	}
 	else
 		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Property is not an integer.")
@@ -447,8 +495,8 @@ void CSendProp::set_float( float value )
 		// Set the value.
 		*(float *)((char *)m_base_entity + m_prop_offset) = value;
 
-		// Force a network update.
-		m_edict->StateChanged();
+		// Mark only this prop as changed.
+		m_edict->StateChanged(m_prop_offset);
 	}
 	else
 		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Property is not a float.")
@@ -464,8 +512,8 @@ void CSendProp::set_string( const char* value )
 		// Write the string to the buffer.
 		V_strncpy(data_buffer, value, DT_MAX_STRING_BUFFERSIZE);
 
-		// Force a network update.
-		m_edict->StateChanged();
+		// Mark only this prop as changed.
+		m_edict->StateChanged(m_prop_offset);
 	}
 	else
 		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Property is not a string.")
@@ -477,8 +525,8 @@ void CSendProp::set_vector( CVector* pVec )
 	{
 		*(Vector *)((char *)m_base_entity + m_prop_offset) = *(Vector *) pVec;
 		
-		// Force a network update.
-		m_edict->StateChanged();
+		// Mark only this prop as changed.
+		m_edict->StateChanged(m_prop_offset);
 	}
 	else
 		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Property is not a vector.")
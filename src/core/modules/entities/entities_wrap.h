@@ -33,6 +33,7 @@
 #include "server_class.h"
 #include <cstdint>
 #include "modules/vecmath/vecmath_wrap.h"
+#include "utility/wrap_macros.h"
 
 //---------------------------------------------------------------------------------
 // Forward declarations
@@ -42,6 +43,7 @@ class CServerNetworkable;
 class CServerUnknown;
 class CServerClass;
 class CSendProp;
+class CDataMapProp;
 
 //---------------------------------------------------------------------------------
 // The base class for all entities.
@@ -80,12 +82,31 @@ public:
 	// Send property methods.
 	virtual CSendProp*					get_prop( const char* prop_name ) const;
 
+	// Datamap field methods.
+	virtual CDataMapProp*				get_datamap( const char* field_name ) const;
+
+	// Returns the indexes of a handle array prop (-1 for stale handles).
+	virtual list						get_handle_indexes( const char* prop_name ) const;
+
+	// Keyvalue methods.
+	virtual object						get_keyvalue( const char* key_name ) const;
+	virtual void						set_keyvalue( const char* key_name, object value );
+	virtual void						set_keyvalues( dict keyvalues );
+
 	virtual edict_t*					get_edict();
 
+	// Edicts are equal if they refer to the same slot and the slot wasn't
+	// reused by another entity since.
+	bool								operator==( object other ) const;
+	bool								operator!=( object other ) const;
+
 private:
 	edict_t*	m_edict_ptr;
 	bool		m_is_valid;
 	int			m_index;
+
+	// Serial number of the slot when the instance was created.
+	int			m_serial_number;
 };
 
 
@@ -167,7 +188,7 @@ public:
 	CServerNetworkable( IServerNetworkable* server_networkable );
 
 	CHandleEntity* get_entity_handle();
-	CEdict* get_edict();
+	object get_edict();
 	virtual const char* get_class_name();
 
 private:
@@ -29,6 +29,17 @@
 //---------------------------------------------------------------------------------
 #include "entities_generator_wrap.h"
 #include "entities_wrap.h"
+#include "entities_datamaps.h"
+#include "entities_attributes.h"
+#include "entities_handles.h"
+#include "entities_transmit.h"
+#include "entities_spawn.h"
+#include "entities_lump.h"
+#include "entities_cache.h"
+#include "entities_scheduler.h"
+#include "entities_outputs.h"
+#include "entities_damage.h"
+#include "entities_datastore.h"
 #include "modules/export_main.h"
 #include "utility/sp_util.h"
 
@@ -47,6 +58,16 @@ void export_server_entity();
 void export_server_networkable();
 void export_edict();
 void export_send_prop();
+void export_datamap_prop();
+void export_entity_attribute();
+void export_transmit_manager();
+void export_entity_spawn_queue();
+void export_map_entity_lump();
+void export_edict_cache();
+void export_entity_scheduler();
+void export_output_listener_manager();
+void export_damage_manager();
+void export_data_store();
 void export_entity_generator();
 
 //---------------------------------------------------------------------------------
@@ -60,6 +81,16 @@ DECLARE_SP_MODULE(entity_c)
 	export_server_entity();
 	export_server_networkable();
 	export_send_prop();
+	export_datamap_prop();
+	export_entity_attribute();
+	export_transmit_manager();
+	export_entity_spawn_queue();
+	export_map_entity_lump();
+	export_edict_cache();
+	export_entity_scheduler();
+	export_output_listener_manager();
+	export_damage_manager();
+	export_data_store();
 	export_edict();
 	export_entity_generator();
 }
@@ -135,6 +166,11 @@ void export_server_unknown()
 	BOOST_FUNCTION(index_of_pointer,
 		"Returns the index of the given BaseEntity pointer"
 	);
+
+	BOOST_FUNCTION(indexes_from_inthandles,
+		"Returns a list with the entity indexes of the given int handles (-1 for stale handles).",
+		args("handles")
+	);
 }
 
 //---------------------------------------------------------------------------------
@@ -178,8 +214,7 @@ void export_server_networkable()
 
 		CLASS_METHOD(CServerNetworkable,
 			get_edict,
-			"Returns the CEdict instance of this entity.",
-			manage_new_object_policy()
+			"Returns the CEdict instance of this entity."
 		)
 
 		CLASS_METHOD(CServerNetworkable,
@@ -258,6 +293,56 @@ void export_edict()
 			manage_new_object_policy()
 		)
 
+		CLASS_METHOD(CEdict,
+			get_datamap,
+			"Returns a datamap field based on the given name.",
+			args("field_name"),
+			manage_new_object_policy()
+		)
+
+		CLASS_METHOD(CEdict,
+			get_handle_indexes,
+			"Returns a list with the entity indexes of the given handle array prop (-1 for stale handles).",
+			args("prop_name")
+		)
+
+		CLASS_METHOD(CEdict,
+			get_keyvalue,
+			"Returns the value of the given keyvalue, converted to the type of its datamap field.",
+			args("key_name")
+		)
+
+		CLASS_METHOD(CEdict,
+			set_keyvalue,
+			"Sets the value of the given keyvalue.",
+			args("key_name", "value")
+		)
+
+		CLASS_METHOD(CEdict,
+			set_keyvalues,
+			"Sets all keyvalues of the given dictionary.",
+			args("keyvalues")
+		)
+
+		CLASS_METHOD_SPECIAL(CEdict,
+			"__eq__",
+			operator==,
+			args("other"),
+			"Returns True if both instances refer to the same entity in the same edict slot."
+		)
+
+		CLASS_METHOD_SPECIAL(CEdict,
+			"__ne__",
+			operator!=,
+			args("other"),
+			"Returns True if the instances refer to different edict slots or entities."
+		)
+
+		CLASS_METHOD_SPECIAL(CEdict,
+			"__hash__",
+			get_index
+		)
+
 	BOOST_END_CLASS()
 }
 
@@ -337,6 +422,757 @@ void export_send_prop()
 	BOOST_END_CLASS()
 }
 
+//---------------------------------------------------------------------------------
+// Exports CDataMapProp.
+//---------------------------------------------------------------------------------
+void export_datamap_prop()
+{
+	// Wrap the datamap field type.
+	BOOST_ENUM( fieldtype_t )
+		ENUM_VALUE( "FIELD_VOID", FIELD_VOID )
+		ENUM_VALUE( "FIELD_FLOAT", FIELD_FLOAT )
+		ENUM_VALUE( "FIELD_STRING", FIELD_STRING )
+		ENUM_VALUE( "FIELD_VECTOR", FIELD_VECTOR )
+		ENUM_VALUE( "FIELD_QUATERNION", FIELD_QUATERNION )
+		ENUM_VALUE( "FIELD_INTEGER", FIELD_INTEGER )
+		ENUM_VALUE( "FIELD_BOOLEAN", FIELD_BOOLEAN )
+		ENUM_VALUE( "FIELD_SHORT", FIELD_SHORT )
+		ENUM_VALUE( "FIELD_CHARACTER", FIELD_CHARACTER )
+		ENUM_VALUE( "FIELD_COLOR32", FIELD_COLOR32 )
+		ENUM_VALUE( "FIELD_EMBEDDED", FIELD_EMBEDDED )
+		ENUM_VALUE( "FIELD_CUSTOM", FIELD_CUSTOM )
+		ENUM_VALUE( "FIELD_CLASSPTR", FIELD_CLASSPTR )
+		ENUM_VALUE( "FIELD_EHANDLE", FIELD_EHANDLE )
+		ENUM_VALUE( "FIELD_EDICT", FIELD_EDICT )
+		ENUM_VALUE( "FIELD_POSITION_VECTOR", FIELD_POSITION_VECTOR )
+		ENUM_VALUE( "FIELD_TIME", FIELD_TIME )
+		ENUM_VALUE( "FIELD_TICK", FIELD_TICK )
+		ENUM_VALUE( "FIELD_MODELNAME", FIELD_MODELNAME )
+		ENUM_VALUE( "FIELD_SOUNDNAME", FIELD_SOUNDNAME )
+		ENUM_VALUE( "FIELD_INPUT", FIELD_INPUT )
+		ENUM_VALUE( "FIELD_FUNCTION", FIELD_FUNCTION )
+		ENUM_VALUE( "FIELD_VMATRIX", FIELD_VMATRIX )
+		ENUM_VALUE( "FIELD_VMATRIX_WORLDSPACE", FIELD_VMATRIX_WORLDSPACE )
+		ENUM_VALUE( "FIELD_MATRIX3X4_WORLDSPACE", FIELD_MATRIX3X4_WORLDSPACE )
+		ENUM_VALUE( "FIELD_INTERVAL", FIELD_INTERVAL )
+		ENUM_VALUE( "FIELD_MODELINDEX", FIELD_MODELINDEX )
+		ENUM_VALUE( "FIELD_MATERIALINDEX", FIELD_MATERIALINDEX )
+		ENUM_VALUE( "FIELD_VECTOR2D", FIELD_VECTOR2D )
+	BOOST_END_CLASS()
+
+	// Can only be instantiated by C++, never python.
+	// Scripts should be accessing CDataMapProp instances from
+	// a CEdict instance.
+	BOOST_ABSTRACT_CLASS(CDataMapProp)
+
+		CLASS_METHOD(CDataMapProp,
+			get_type,
+			"Returns the type of this field."
+		)
+
+		CLASS_METHOD(CDataMapProp,
+			get_offset,
+			"Returns the offset of this field or -1 if it was not found."
+		)
+
+		CLASS_METHOD(CDataMapProp,
+			set_int,
+			"Sets this field's integer value.",
+			args("value")
+		)
+
+		CLASS_METHOD(CDataMapProp,
+			set_float,
+			"Sets this field's floating point value.",
+			args("value")
+		)
+
+		CLASS_METHOD(CDataMapProp,
+			set_string,
+			"Sets this field's string value.",
+			args("value")
+		)
+
+		CLASS_METHOD(CDataMapProp,
+			set_vector,
+			"Sets this field's vector value.",
+			args("value")
+		)
+
+		CLASS_METHOD(CDataMapProp,
+			get_int,
+			"Returns this field's value as an integer."
+		)
+
+		CLASS_METHOD(CDataMapProp,
+			get_float,
+			"Returns this field's floating point value."
+		)
+
+		CLASS_METHOD(CDataMapProp,
+			get_string,
+			"Returns this field's string value."
+		)
+
+		CLASS_METHOD(CDataMapProp,
+			get_vector,
+			"Returns this field's vector value.",
+			manage_new_object_policy()
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(set_datamap_vtable_index,
+		"Sets the vtable index of CBaseEntity::GetDataDescMap (without the linux offset).",
+		args("index")
+	);
+
+	BOOST_FUNCTION(get_datamap_vtable_index,
+		"Returns the vtable index of CBaseEntity::GetDataDescMap."
+	);
+}
+
+//---------------------------------------------------------------------------------
+// Exports CEntityAttribute.
+//---------------------------------------------------------------------------------
+void export_entity_attribute()
+{
+	BOOST_ENUM( EntityAttributeSource )
+		ENUM_VALUE( "ATTRIBUTE_SENDPROP", ATTRIBUTE_SENDPROP )
+		ENUM_VALUE( "ATTRIBUTE_DATAMAP", ATTRIBUTE_DATAMAP )
+	BOOST_END_CLASS()
+
+	class_<CEntityAttribute, boost::noncopyable>("CEntityAttribute", init<const char*, EntityAttributeSource, const char*>())
+
+		CLASS_METHOD(CEntityAttribute,
+			set_bool_values,
+			"Makes the attribute return True/False and sets the values to compare against.",
+			args("true_value", "false_value")
+		)
+
+		CLASS_METHOD(CEntityAttribute,
+			get_name,
+			"Returns the prop or datamap field name of this attribute."
+		)
+
+		CLASS_METHOD_SPECIAL(CEntityAttribute,
+			"__get__",
+			__get__
+		)
+
+		CLASS_METHOD_SPECIAL(CEntityAttribute,
+			"__set__",
+			__set__
+		)
+
+	BOOST_END_CLASS()
+}
+
+//---------------------------------------------------------------------------------
+// Exports CTransmitManager.
+//---------------------------------------------------------------------------------
+void export_transmit_manager()
+{
+	BOOST_ABSTRACT_CLASS(CTransmitManager)
+
+		CLASS_METHOD(CTransmitManager,
+			hide_entity,
+			"Stops transmitting the entity to the given player.",
+			args("entity_index", "player_index")
+		)
+
+		CLASS_METHOD(CTransmitManager,
+			show_entity,
+			"Transmits the entity to the given player again.",
+			args("entity_index", "player_index")
+		)
+
+		CLASS_METHOD(CTransmitManager,
+			hide_entity_from_all,
+			"Stops transmitting the entity to all players.",
+			args("entity_index")
+		)
+
+		CLASS_METHOD(CTransmitManager,
+			is_entity_hidden,
+			"Returns True if the entity is hidden from the given player.",
+			args("entity_index", "player_index")
+		)
+
+		CLASS_METHOD(CTransmitManager,
+			set_team_only,
+			"Only transmits the entity to players of the given team. Use 0 to disable the rule.",
+			args("entity_index", "team")
+		)
+
+		CLASS_METHOD(CTransmitManager,
+			set_max_distance,
+			"Doesn't transmit the entity to players that are farther away. Use 0 to disable the rule.",
+			args("entity_index", "distance")
+		)
+
+		CLASS_METHOD(CTransmitManager,
+			clear_rules,
+			"Removes all transmit rules of the entity.",
+			args("entity_index")
+		)
+
+		CLASS_METHOD(CTransmitManager,
+			clear_all_rules,
+			"Removes the transmit rules of all entities."
+		)
+
+		CLASS_METHOD(CTransmitManager,
+			clear_player,
+			"Removes the given player from all per player rules.",
+			args("player_index")
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_transmit_manager,
+		"Returns the CTransmitManager instance",
+		reference_existing_object_policy()
+	);
+}
+
+//---------------------------------------------------------------------------------
+// Exports CEntitySpawnQueue.
+//---------------------------------------------------------------------------------
+void export_entity_spawn_queue()
+{
+	BOOST_ABSTRACT_CLASS(CEntitySpawnQueue)
+
+		CLASS_METHOD(CEntitySpawnQueue,
+			spawn_batch,
+			"Queues a sequence of (classname[, keyvalues[, origin]]) descriptors. The callback (or None) is called with the batch id and the list of created indexes (-1 for failures) once all entities of the batch were spawned. Returns the batch id.",
+			args("descriptors", "callback")
+		)
+
+		CLASS_METHOD(CEntitySpawnQueue,
+			remove_batch,
+			"Queues the removal of the given entity indexes.",
+			args("indexes")
+		)
+
+		CLASS_METHOD(CEntitySpawnQueue,
+			set_budget,
+			"Sets the maximum number of spawns and removals per frame (0 means no limit).",
+			args("budget")
+		)
+
+		CLASS_METHOD(CEntitySpawnQueue,
+			get_budget,
+			"Returns the maximum number of spawns and removals per frame."
+		)
+
+		CLASS_METHOD(CEntitySpawnQueue,
+			get_pending_spawns,
+			"Returns the number of queued spawns."
+		)
+
+		CLASS_METHOD(CEntitySpawnQueue,
+			get_pending_removals,
+			"Returns the number of queued removals."
+		)
+
+		CLASS_METHOD(CEntitySpawnQueue,
+			clear,
+			"Drops all queued spawns and removals without calling their callbacks."
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_entity_spawn_queue,
+		"Returns the CEntitySpawnQueue instance",
+		reference_existing_object_policy()
+	);
+}
+
+//---------------------------------------------------------------------------------
+// Exports CMapEntityLump and CMapEntityBlock.
+//---------------------------------------------------------------------------------
+void export_map_entity_lump()
+{
+	BOOST_ABSTRACT_CLASS(CMapEntityBlock)
+
+		CLASS_METHOD(CMapEntityBlock,
+			get_index,
+			"Returns the position of the block in the entity lump."
+		)
+
+		CLASS_METHOD(CMapEntityBlock,
+			get_classname,
+			"Returns the classname of the block or None."
+		)
+
+		CLASS_METHOD(CMapEntityBlock,
+			get_targetname,
+			"Returns the targetname of the block or None."
+		)
+
+		CLASS_METHOD(CMapEntityBlock,
+			get_hammer_id,
+			"Returns the hammer id of the block (0 if it has none)."
+		)
+
+		CLASS_METHOD(CMapEntityBlock,
+			get_value,
+			"Returns the first value of the given key or None.",
+			args("key")
+		)
+
+		CLASS_METHOD(CMapEntityBlock,
+			get_values,
+			"Returns a list with all values of the given key.",
+			args("key")
+		)
+
+		CLASS_METHOD(CMapEntityBlock,
+			get_keyvalues,
+			"Returns a list of (key, value) tuples in the order of the lump."
+		)
+
+		CLASS_METHOD_SPECIAL(CMapEntityBlock,
+			"__len__",
+			get_count
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_ABSTRACT_CLASS(CMapEntityLump)
+
+		CLASS_METHOD(CMapEntityLump,
+			get_block,
+			"Returns the block at the given position.",
+			args("index")
+		)
+
+		CLASS_METHOD(CMapEntityLump,
+			find_by_classname,
+			"Returns a list with all blocks of the given classname.",
+			args("classname")
+		)
+
+		CLASS_METHOD(CMapEntityLump,
+			find_by_targetname,
+			"Returns a list with all blocks of the given targetname.",
+			args("targetname")
+		)
+
+		CLASS_METHOD(CMapEntityLump,
+			find_by_hammer_id,
+			"Returns the block of the given hammer id or None.",
+			args("hammer_id")
+		)
+
+		CLASS_METHOD(CMapEntityLump,
+			find_by_keyvalue,
+			"Returns a list with all blocks that have the given key set to the given value.",
+			args("key", "value")
+		)
+
+		CLASS_METHOD_SPECIAL(CMapEntityLump,
+			"__len__",
+			get_count
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_map_entity_lump,
+		"Returns the CMapEntityLump instance",
+		reference_existing_object_policy()
+	);
+}
+
+//---------------------------------------------------------------------------------
+// Exports the CEdict cache.
+//---------------------------------------------------------------------------------
+void export_edict_cache()
+{
+	BOOST_FUNCTION(get_cached_edict,
+		"Returns the shared CEdict instance of the given index or None if the edict is free.",
+		args("index")
+	);
+}
+
+//---------------------------------------------------------------------------------
+// Exports CEntityScheduler.
+//---------------------------------------------------------------------------------
+DECLARE_CLASS_METHOD_OVERLOAD(CEntityScheduler, schedule, 3, 5);
+
+void export_entity_scheduler()
+{
+	BOOST_ABSTRACT_CLASS(CEntityScheduler)
+
+		CLASS_METHOD_OVERLOAD(CEntityScheduler,
+			schedule,
+			"Calls callback(index, *args) after the given delay and then every interval seconds (0 means once). The entry is dropped when the entity is removed. Returns the id of the entry.",
+			args("index", "delay", "callback", "interval", "args")
+		)
+
+		CLASS_METHOD(CEntityScheduler,
+			cancel,
+			"Cancels the entry with the given id.",
+			args("id")
+		)
+
+		CLASS_METHOD(CEntityScheduler,
+			cancel_all,
+			"Cancels all entries of the given entity.",
+			args("index")
+		)
+
+		CLASS_METHOD(CEntityScheduler,
+			is_scheduled,
+			"Returns True if the entry with the given id is still scheduled.",
+			args("id")
+		)
+
+		CLASS_METHOD_SPECIAL(CEntityScheduler,
+			"__len__",
+			get_count
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_entity_scheduler,
+		"Returns the CEntityScheduler instance",
+		reference_existing_object_policy()
+	);
+}
+
+//---------------------------------------------------------------------------------
+// Exports COutputListenerManager.
+//---------------------------------------------------------------------------------
+DECLARE_CLASS_METHOD_OVERLOAD(COutputListenerManager, register_listener, 2, 5);
+
+void export_output_listener_manager()
+{
+	BOOST_ABSTRACT_CLASS(COutputListenerManager)
+
+		CLASS_METHOD(COutputListenerManager,
+			set_fire_output_function,
+			"Sets the address of CBaseEntityOutput::FireOutput. Only Linux has a signature for it, so output listeners are not available on Windows.",
+			args("pointer")
+		)
+
+		CLASS_METHOD_OVERLOAD(COutputListenerManager,
+			register_listener,
+			"Calls callback(output, activator_index, caller_index, delay, owner_index) for every matching output. The owner is the entity the output belongs to, which the classname and targetname filters are matched against. Missing entities have an index of -1. Empty filters match everything. Batched listeners are called once per frame with a list of those tuples. Only available on Linux. Returns the id of the listener.",
+			args("callback", "output", "classname", "targetname", "batched")
+		)
+
+		CLASS_METHOD(COutputListenerManager,
+			unregister_listener,
+			"Unregisters the listener with the given id.",
+			args("id")
+		)
+
+		CLASS_METHOD_SPECIAL(COutputListenerManager,
+			"__len__",
+			get_count
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_output_listener_manager,
+		"Returns the COutputListenerManager instance",
+		reference_existing_object_policy()
+	);
+}
+
+//---------------------------------------------------------------------------------
+// Exports CDamageManager.
+//---------------------------------------------------------------------------------
+DECLARE_CLASS_METHOD_OVERLOAD(CDamageManager, add_rule, 1, 8);
+
+void export_damage_manager()
+{
+	BOOST_ENUM( DamageAction )
+		ENUM_VALUE( "DAMAGE_MULTIPLY", DAMAGE_MULTIPLY )
+		ENUM_VALUE( "DAMAGE_CLAMP", DAMAGE_CLAMP )
+		ENUM_VALUE( "DAMAGE_BLOCK", DAMAGE_BLOCK )
+		ENUM_VALUE( "DAMAGE_CALLBACK", DAMAGE_CALLBACK )
+	BOOST_END_CLASS()
+
+	BOOST_ABSTRACT_CLASS(CTakeDamageInfoView)
+
+		CLASS_PROPERTY_READ_ONLY(CTakeDamageInfoView,
+			"victim",
+			get_victim,
+			"Returns the index of the entity that takes the damage."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CTakeDamageInfoView,
+			"inflictor",
+			get_inflictor,
+			"Returns the index of the inflictor or -1."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CTakeDamageInfoView,
+			"attacker",
+			get_attacker,
+			"Returns the index of the attacker or -1."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CTakeDamageInfoView,
+			"weapon",
+			get_weapon,
+			"Returns the index of the weapon or -1."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CTakeDamageInfoView,
+			"hitgroup",
+			get_hitgroup,
+			"Returns the hitgroup of the victim's last trace attack. Always 0 for non-players."
+		)
+
+		CLASS_PROPERTY_READWRITE(CTakeDamageInfoView,
+			"damage",
+			get_damage,
+			set_damage,
+			"Returns or sets the damage of the hit."
+		)
+
+		CLASS_PROPERTY_READWRITE(CTakeDamageInfoView,
+			"damage_type",
+			get_damage_type,
+			set_damage_type,
+			"Returns or sets the damage type bits of the hit."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CTakeDamageInfoView,
+			"pointer",
+			get_pointer,
+			"Returns the address of the CTakeDamageInfo."
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_ABSTRACT_CLASS(CDamageManager)
+
+		CLASS_METHOD(CDamageManager,
+			set_take_damage_function,
+			"Sets the address of CBaseEntity::TakeDamage.",
+			args("pointer")
+		)
+
+		CLASS_METHOD(CDamageManager,
+			set_info_offsets,
+			"Sets the offsets of the CTakeDamageInfo members.",
+			args("inflictor", "attacker", "weapon", "damage", "damage_type")
+		)
+
+		CLASS_METHOD_OVERLOAD(CDamageManager,
+			add_rule,
+			"Adds a rule and returns its id. Rules are applied in the order they were added. Filters of 0, -1 or an empty string match every hit. Callbacks are called with a CTakeDamageInfoView, which raises a RuntimeError once the call returned, and block the hit by returning False.",
+			args("action", "value", "attacker_team", "victim_team", "weapon", "hitgroup", "damage_type", "callback")
+		)
+
+		CLASS_METHOD(CDamageManager,
+			remove_rule,
+			"Removes the rule with the given id.",
+			args("id")
+		)
+
+		CLASS_METHOD(CDamageManager,
+			clear,
+			"Removes all rules."
+		)
+
+		CLASS_METHOD_SPECIAL(CDamageManager,
+			"__len__",
+			get_count
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_damage_manager,
+		"Returns the CDamageManager instance",
+		reference_existing_object_policy()
+	);
+}
+
+//---------------------------------------------------------------------------------
+// Exports CDataStore, CDataStoreField and CDataStoreRow.
+//---------------------------------------------------------------------------------
+DECLARE_CLASS_METHOD_OVERLOAD(CDataStore, add_field, 2, 3);
+
+void export_data_store()
+{
+	BOOST_ENUM( DataStoreFieldType )
+		ENUM_VALUE( "DATASTORE_INT", DATASTORE_INT )
+		ENUM_VALUE( "DATASTORE_FLOAT", DATASTORE_FLOAT )
+		ENUM_VALUE( "DATASTORE_VECTOR", DATASTORE_VECTOR )
+		ENUM_VALUE( "DATASTORE_BYTES", DATASTORE_BYTES )
+	BOOST_END_CLASS()
+
+	BOOST_ENUM( DataStoreScope )
+		ENUM_VALUE( "DATASTORE_PLAYERS", DATASTORE_PLAYERS )
+		ENUM_VALUE( "DATASTORE_EDICTS", DATASTORE_EDICTS )
+	BOOST_END_CLASS()
+
+	BOOST_ABSTRACT_CLASS(CDataStoreField)
+
+		CLASS_PROPERTY_READ_ONLY(CDataStoreField,
+			"name",
+			get_name,
+			"Returns the name of the field."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CDataStoreField,
+			"type",
+			get_type,
+			"Returns the DataStoreFieldType of the field."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CDataStoreField,
+			"size",
+			get_size,
+			"Returns the number of values per row."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CDataStoreField,
+			"view",
+			get_view,
+			"Returns a writable memoryview of the whole column. Int fields have one int per row, float fields one float, vector fields three floats and bytes fields size bytes."
+		)
+
+		CLASS_METHOD(CDataStoreField,
+			get,
+			"Returns the value of the row.",
+			args("index")
+		)
+
+		CLASS_METHOD(CDataStoreField,
+			set,
+			"Sets the value of the row.",
+			args("index", "value")
+		)
+
+		CLASS_METHOD(CDataStoreField,
+			reset,
+			"Zeroes the value of the row.",
+			args("index")
+		)
+
+		CLASS_METHOD(CDataStoreField,
+			reset_all,
+			"Zeroes all rows."
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_ABSTRACT_CLASS(CDataStoreRow)
+
+		CLASS_PROPERTY_READ_ONLY(CDataStoreRow,
+			"index",
+			get_index,
+			"Returns the index of the row."
+		)
+
+		CLASS_METHOD(CDataStoreRow,
+			get_store,
+			"Returns the CDataStore of the row.",
+			reference_existing_object_policy()
+		)
+
+		CLASS_METHOD_SPECIAL(CDataStoreRow,
+			"__getattr__",
+			__getattr__
+		)
+
+		CLASS_METHOD_SPECIAL(CDataStoreRow,
+			"__setattr__",
+			__setattr__
+		)
+
+		CLASS_METHOD(CDataStoreRow,
+			reset,
+			"Zeroes all fields of the row."
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_ABSTRACT_CLASS(CDataStore)
+
+		CLASS_PROPERTY_READ_ONLY(CDataStore,
+			"name",
+			get_name,
+			"Returns the name of the store."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CDataStore,
+			"scope",
+			get_scope,
+			"Returns the DataStoreScope of the store."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CDataStore,
+			"row_count",
+			get_row_count,
+			"Returns the number of rows."
+		)
+
+		CLASS_METHOD_OVERLOAD_RET(CDataStore,
+			add_field,
+			"Adds a field and returns it. Bytes fields need a size. Adding an existing field with the same type returns the existing field.",
+			args("name", "type", "size"),
+			reference_existing_object_policy()
+		)
+
+		CLASS_METHOD(CDataStore,
+			get_field,
+			"Returns the field with the given name.",
+			args("name"),
+			reference_existing_object_policy()
+		)
+
+		CLASS_METHOD(CDataStore,
+			has_field,
+			"Returns whether the field exists.",
+			args("name")
+		)
+
+		CLASS_METHOD(CDataStore,
+			get_field_names,
+			"Returns a list with the names of all fields."
+		)
+
+		CLASS_METHOD(CDataStore,
+			get_row,
+			"Returns a CDataStoreRow, which maps attribute access to the fields of the row.",
+			args("index"),
+			manage_new_object_policy()
+		)
+
+		CLASS_METHOD_SPECIAL(CDataStore,
+			"__getitem__",
+			get_row,
+			manage_new_object_policy()
+		)
+
+		CLASS_METHOD(CDataStore,
+			reset_row,
+			"Zeroes all fields of the row.",
+			args("index")
+		)
+
+		CLASS_METHOD(CDataStore,
+			reset_all,
+			"Zeroes all rows."
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_data_store,
+		"Returns the data store with the given name and creates it if it doesn't exist yet. Rows are zeroed when the player disconnects or the edict is freed.",
+		args("name", "scope"),
+		reference_existing_object_policy()
+	);
+}
+
 void export_entity_generator()
 {
 	BOOST_GENERATOR_CLASS(CEntityGenerator)
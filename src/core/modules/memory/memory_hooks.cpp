@@ -189,6 +189,7 @@ HookRetBuf_t* CCallbackManager::DoPostCalls(CDetour* pDetour)
 // ============================================================================
 CStackData::CStackData(CDetour* pDetour)
 {
+	m_pDetour    = pDetour;
 	m_pRegisters = pDetour->GetAsmBridge()->GetConv()->GetRegisters();
 	m_pFunction  = pDetour->GetFuncObj();
 	m_pStack     = m_pFunction->GetStack();
@@ -213,30 +214,17 @@ object CStackData::get_item(unsigned int iIndex)
 	if (retval)
 		return retval;
 
+	void* pAddr = GetArgumentAddress(m_pDetour, iIndex);
 	if (m_pFunction->GetConvention() == CONV_THISCALL)
 	{
 		if (iIndex == 0)
 		{
-		#ifdef __linux__
-			unsigned long thisptr = *(unsigned long *) (m_pRegisters->r_esp + 4);
-		#else
-			unsigned long thisptr = m_pRegisters->r_ecx;
-		#endif
-			retval = m_mapCache[0] = object(CPointer(thisptr));
+			retval = m_mapCache[0] = object(CPointer(*(unsigned long *) pAddr));
 			return retval;
 		}
 	}
 
 	ArgNode_t* pArgNode = m_pStack->GetArgument(m_pFunction->GetConvention() == CONV_THISCALL ? iIndex-1 : iIndex);
-	int        offset   = pArgNode->m_nOffset;
-
-	#ifdef __linux__
-		if (m_pFunction->GetConvention() == CONV_THISCALL)
-			// Add size of "this" pointer
-			offset += 4;
-	#endif
-
-	void* pAddr = (void *) (m_pRegisters->r_esp + 4 + offset);
 	switch(pArgNode->m_pArg->GetType())
 	{
 		case TYPE_BOOL:      retval = ReadAddr<bool>(pAddr); break;
@@ -270,29 +258,17 @@ void CStackData::set_item(unsigned int iIndex, object value)
 	m_mapCache[iIndex] = value;
 
 	// Update address
+	void* ulAddr = GetArgumentAddress(m_pDetour, iIndex);
 	if (m_pFunction->GetConvention() == CONV_THISCALL)
 	{
 		if (iIndex == 0)
 		{
-		#ifdef __linux__
-			SetAddr<unsigned long>((void *) (m_pRegisters->r_esp + 4), value);
-		#else
-			m_pRegisters->r_ecx = extract<unsigned long>(value);
-		#endif
+			SetAddr<unsigned long>(ulAddr, value);
 			return;
 		}
 	}
 
 	ArgNode_t* pArgNode = m_pStack->GetArgument(m_pFunction->GetConvention() == CONV_THISCALL ? iIndex-1 : iIndex);
-	int        offset   = pArgNode->m_nOffset;
-
-	#ifdef __linux__
-		if (m_pFunction->GetConvention() == CONV_THISCALL)
-			// Add size of "this" pointer
-			offset += 4;
-	#endif
-
-	void* ulAddr = (void*)(m_pRegisters->r_esp + 4 + offset);
 	switch(pArgNode->m_pArg->GetType())
 	{
 		case TYPE_BOOL:      SetAddr<bool>(ulAddr, value); break;
@@ -312,4 +288,37 @@ void CStackData::set_item(unsigned int iIndex, object value)
 		case TYPE_STRING:    SetAddr<const char *>(ulAddr, value); break;
 		default: BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Unknown type.")
 	}
-}
\ No newline at end of file
+}
+
+
+// ============================================================================
+// >> Native hook helpers
+// ============================================================================
+void* GetArgumentAddress(CDetour* pDetour, unsigned int iIndex)
+{
+	CRegisterObj* pRegisters = pDetour->GetAsmBridge()->GetConv()->GetRegisters();
+	CFuncObj*     pFunction  = pDetour->GetFuncObj();
+
+	if (pFunction->GetConvention() == CONV_THISCALL)
+	{
+		if (iIndex == 0)
+		{
+		#ifdef __linux__
+			return (void *) (pRegisters->r_esp + 4);
+		#else
+			return (void *) &pRegisters->r_ecx;
+		#endif
+		}
+		iIndex--;
+	}
+
+	int offset = pFunction->GetStack()->GetArgument(iIndex)->m_nOffset;
+
+	#ifdef __linux__
+		if (pFunction->GetConvention() == CONV_THISCALL)
+			// Add size of "this" pointer
+			offset += 4;
+	#endif
+
+	return (void *) (pRegisters->r_esp + 4 + offset);
+}
@@ -49,10 +49,16 @@ public:
 	unsigned int get_arg_num();
 
 private:
+	CDetour*              m_pDetour;
 	CRegisterObj*         m_pRegisters;
 	CFuncObj*             m_pFunction;
 	CFuncStack*           m_pStack;
 	map<int, object>      m_mapCache;
 };
 
+// Returns the address of an argument of a hooked function. This is used by
+// native hooks that don't need a CStackData. Index 0 is the this pointer for
+// thiscall functions.
+void* GetArgumentAddress(CDetour* pDetour, unsigned int iIndex);
+
 #endif // MEMORY_HOOKS_H
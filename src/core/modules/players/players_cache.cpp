@@ -0,0 +1,149 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+// ----------------------------------------------------------------------------
+// Includes
+// ----------------------------------------------------------------------------
+#include "players_cache.h"
+#include "players_wrap.h"
+#include "utility/sp_util.h"
+#include "game/server/iplayerinfo.h"
+
+// ----------------------------------------------------------------------------
+// External variables.
+// ----------------------------------------------------------------------------
+extern IPlayerInfoManager* playerinfomanager;
+
+// ----------------------------------------------------------------------------
+// Global accessor.
+// ----------------------------------------------------------------------------
+CPlayerInfoCache g_PlayerInfoCache;
+
+// ----------------------------------------------------------------------------
+// Exposed functions.
+// ----------------------------------------------------------------------------
+object get_cached_playerinfo( int index )
+{
+	return g_PlayerInfoCache.get_player_info(index);
+}
+
+// ----------------------------------------------------------------------------
+// CPlayerInfoCache code.
+// ----------------------------------------------------------------------------
+CPlayerInfoCache::CPlayerInfoCache()
+{
+	for( int i = 0; i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+	{
+		m_Entries[i].iSerialNumber = -1;
+		m_Entries[i].pPlayerInfo = NULL;
+		m_Entries[i].pEdict = NULL;
+		m_Entries[i].pPlayer = NULL;
+	}
+}
+
+object CPlayerInfoCache::get_player_info( int index )
+{
+	if( index < 1 || index > gpGlobals->maxClients || index > ABSOLUTE_PLAYER_LIMIT )
+		return object();
+
+	edict_t* pEdict = PEntityOfEntIndex(index);
+	if( !pEdict || pEdict->IsFree() )
+		return object();
+
+	CacheEntry_t& entry = m_Entries[index];
+	if( entry.iSerialNumber != pEdict->m_NetworkSerialNumber )
+	{
+		// The plugin might have missed the player being put in the server.
+		update(pEdict);
+		if( entry.iSerialNumber != pEdict->m_NetworkSerialNumber )
+			return object();
+	}
+
+	if( !entry.pPlayer )
+	{
+		// The Python object owns the instance, so it outlives the cache entry.
+		entry.pPlayer = new CPlayerInfo();
+		entry.pPlayer->set_player(entry.pPlayerInfo, entry.pEdict);
+
+		manage_new_object::apply<CPlayerInfo *>::type convert;
+		entry.playerinfo = object(handle<>(convert(entry.pPlayer)));
+	}
+
+	return entry.playerinfo;
+}
+
+void CPlayerInfoCache::update( edict_t* pEdict )
+{
+	if( !pEdict || pEdict->IsFree() )
+		return;
+
+	int index = IndexOfEdict(pEdict);
+	if( index < 1 || index > ABSOLUTE_PLAYER_LIMIT )
+		return;
+
+	IPlayerInfo* pPlayerInfo = playerinfomanager->GetPlayerInfo(pEdict);
+	if( !pPlayerInfo )
+	{
+		invalidate(index);
+		return;
+	}
+
+	// Another player in the slot gets a new instance.
+	CacheEntry_t& entry = m_Entries[index];
+	if( entry.pPlayerInfo != pPlayerInfo || entry.iSerialNumber != pEdict->m_NetworkSerialNumber )
+		invalidate(index);
+
+	entry.iSerialNumber = pEdict->m_NetworkSerialNumber;
+	entry.pPlayerInfo = pPlayerInfo;
+	entry.pEdict = pEdict;
+}
+
+void CPlayerInfoCache::invalidate( int index )
+{
+	if( index < 0 || index > ABSOLUTE_PLAYER_LIMIT )
+		return;
+
+	CacheEntry_t& entry = m_Entries[index];
+	entry.iSerialNumber = -1;
+	entry.pPlayerInfo = NULL;
+	entry.pEdict = NULL;
+
+	if( !entry.pPlayer )
+		return;
+
+	// Scripts might still reference the instance, it raises from now on.
+	entry.pPlayer->set_player(NULL, NULL);
+	entry.pPlayer = NULL;
+	entry.playerinfo = object();
+}
+
+void CPlayerInfoCache::clear()
+{
+	for( int i = 0; i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+	{
+		invalidate(i);
+	}
+}
@@ -0,0 +1,86 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _PLAYERS_CACHE_H
+#define _PLAYERS_CACHE_H
+
+// ----------------------------------------------------------------------------
+// Includes.
+// ----------------------------------------------------------------------------
+#include "const.h"
+#include "edict.h"
+#include "players_wrap.h"
+#include "utility/wrap_macros.h"
+
+// ----------------------------------------------------------------------------
+// Caches one CPlayerInfo per connected player. The instance is created on the
+// first lookup and returned by every later lookup and generator, so they
+// don't allocate. When the player leaves, the instance is detached and raises
+// on use, and the next player of the slot gets a new one. References kept by
+// scripts never silently point to another player.
+// ----------------------------------------------------------------------------
+class CPlayerInfoCache
+{
+public:
+	CPlayerInfoCache();
+
+	// Returns the CPlayerInfo instance of the slot or None if there's no player.
+	object	get_player_info( int index );
+
+	// Stores the player of the edict for the slot.
+	void	update( edict_t* pEdict );
+
+	// Detaches the slot's instance and drops its Python object.
+	void	invalidate( int index );
+
+	// Detaches all instances and drops their Python objects.
+	void	clear();
+
+private:
+	struct CacheEntry_t
+	{
+		int				iSerialNumber;
+		IPlayerInfo*	pPlayerInfo;
+		edict_t*		pEdict;
+
+		// Owned by the Python object.
+		CPlayerInfo*	pPlayer;
+		object			playerinfo;
+	};
+
+	CacheEntry_t	m_Entries[ABSOLUTE_PLAYER_LIMIT + 1];
+};
+
+// ----------------------------------------------------------------------------
+// Global accessor.
+// ----------------------------------------------------------------------------
+extern CPlayerInfoCache g_PlayerInfoCache;
+
+// ----------------------------------------------------------------------------
+// Exposed functions.
+// ----------------------------------------------------------------------------
+object get_cached_playerinfo( int index );
+
+#endif // _PLAYERS_CACHE_H
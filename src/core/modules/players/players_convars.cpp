@@ -0,0 +1,305 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+// ----------------------------------------------------------------------------
+// Includes.
+// ----------------------------------------------------------------------------
+#include "players_convars.h"
+#include "eiface.h"
+#include "tier0/platform.h"
+#include "utility/sp_util.h"
+
+// ----------------------------------------------------------------------------
+// External variables.
+// ----------------------------------------------------------------------------
+extern IVEngineServer* engine;
+extern CGlobalVars* gpGlobals;
+
+// ----------------------------------------------------------------------------
+// Global instance.
+// ----------------------------------------------------------------------------
+CClientConVarCache g_ClientConVarCache;
+
+// ----------------------------------------------------------------------------
+// CClientConVarCache code.
+// ----------------------------------------------------------------------------
+CClientConVarCache::CClientConVarCache()
+{
+	m_iNextID = 1;
+}
+
+bool CClientConVarCache::is_valid_index( int index )
+{
+	return index > 0 && index <= ABSOLUTE_PLAYER_LIMIT && index <= gpGlobals->maxClients;
+}
+
+object CClientConVarCache::get_value( int index, const char* name )
+{
+	if( !is_valid_index(index) )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index.")
+
+	boost::unordered_map<std::string, object>& values = m_Values[index];
+	boost::unordered_map<std::string, object>::iterator it = values.find(name);
+	if( it != values.end() )
+		return it->second;
+
+	const char* szValue = engine->GetClientConVarValue(index, name);
+	object value(szValue ? szValue : "");
+
+	// Only cache values of connected players, since the engine returns an
+	// empty string for free slots.
+	if( PlayerOfIndex(index) )
+		values[name] = value;
+
+	return value;
+}
+
+object CClientConVarCache::group_by_value( object indexes, const char* name )
+{
+	dict groups;
+	stl_input_iterator<int> iter(indexes), end;
+	for( ; iter != end; ++iter )
+	{
+		int iIndex = *iter;
+		object value = get_value(iIndex, name);
+
+		object group = groups.get(value);
+		if( group.is_none() )
+		{
+			group = boost::python::list();
+			groups[value] = group;
+		}
+
+		group.attr("append")(iIndex);
+	}
+
+	return groups;
+}
+
+int CClientConVarCache::query( object indexes, object names, object callback, float timeout /* = 5.0 */ )
+{
+	if( !PyCallable_Check(callback.ptr()) )
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Callback is not callable.")
+
+	std::vector<std::string> vecNames;
+	stl_input_iterator<const char*> name_iter(names), name_end;
+	for( ; name_iter != name_end; ++name_iter )
+		vecNames.push_back(*name_iter);
+
+	Batch_t batch;
+	batch.id = m_iNextID++;
+	batch.pending = 0;
+	batch.deadline = Plat_FloatTime() + timeout;
+	batch.callback = callback;
+
+	// Validate all indexes first, so no query is sent for a failing batch.
+	std::vector<int> vecIndexes;
+	stl_input_iterator<int> iter(indexes), end;
+	for( ; iter != end; ++iter )
+	{
+		if( !is_valid_index(*iter) )
+			BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index.")
+
+		vecIndexes.push_back(*iter);
+	}
+
+	for( unsigned int j = 0; j < vecIndexes.size(); j++ )
+	{
+		int iIndex = vecIndexes[j];
+
+		// Unanswered queries stay None.
+		dict values;
+		for( unsigned int i = 0; i < vecNames.size(); i++ )
+			values[vecNames[i]] = object();
+
+		batch.results[iIndex] = values;
+
+		// Bots can't answer queries.
+		IPlayerInfo* pPlayerInfo = PlayerOfIndex(iIndex);
+		if( !pPlayerInfo || pPlayerInfo->IsFakeClient() )
+			continue;
+
+		edict_t* pEdict = PEntityOfEntIndex(iIndex);
+		for( unsigned int i = 0; i < vecNames.size(); i++ )
+		{
+			QueryCvarCookie_t cookie = engine->StartQueryCvarValue(pEdict, vecNames[i].c_str());
+			if( cookie == InvalidQueryCvarCookie )
+				continue;
+
+			Query_t query;
+			query.batch_id = batch.id;
+			query.index = iIndex;
+			query.name = vecNames[i];
+			m_Queries[cookie] = query;
+			batch.pending++;
+		}
+	}
+
+	m_Batches.push_back(batch);
+	return batch.id;
+}
+
+void CClientConVarCache::cancel( int id )
+{
+	for( std::vector<Batch_t>::iterator it = m_Batches.begin(); it != m_Batches.end(); ++it )
+	{
+		if( it->id == id )
+		{
+			m_Batches.erase(it);
+			break;
+		}
+	}
+
+	// Answers of the batch are ignored from now on.
+	boost::unordered_map<QueryCvarCookie_t, Query_t>::iterator it = m_Queries.begin();
+	while( it != m_Queries.end() )
+	{
+		if( it->second.batch_id == id )
+			it = m_Queries.erase(it);
+		else
+			++it;
+	}
+}
+
+CClientConVarCache::Batch_t* CClientConVarCache::find_batch( int id )
+{
+	for( unsigned int i = 0; i < m_Batches.size(); i++ )
+	{
+		if( m_Batches[i].id == id )
+			return &m_Batches[i];
+	}
+
+	return NULL;
+}
+
+void CClientConVarCache::resolve( QueryCvarCookie_t cookie, object value )
+{
+	boost::unordered_map<QueryCvarCookie_t, Query_t>::iterator it = m_Queries.find(cookie);
+	if( it == m_Queries.end() )
+		return;
+
+	Batch_t* pBatch = find_batch(it->second.batch_id);
+	if( pBatch )
+	{
+		pBatch->results[it->second.index][it->second.name] = value;
+		pBatch->pending--;
+	}
+
+	m_Queries.erase(it);
+}
+
+void CClientConVarCache::on_query_finished( QueryCvarCookie_t cookie, EQueryCvarValueStatus status, const char* value )
+{
+	if( m_Queries.find(cookie) == m_Queries.end() )
+		return;
+
+	BEGIN_BOOST_PY()
+
+		resolve(cookie, status == eQueryCvarValueStatus_ValueIntact && value ? object(value) : object());
+
+	END_BOOST_PY_NORET()
+}
+
+void CClientConVarCache::invalidate( int index )
+{
+	if( index <= 0 || index > ABSOLUTE_PLAYER_LIMIT )
+		return;
+
+	m_Values[index].clear();
+}
+
+void CClientConVarCache::clear_player( int index )
+{
+	invalidate(index);
+
+	// A disconnected player never answers.
+	std::vector<QueryCvarCookie_t> cookies;
+	boost::unordered_map<QueryCvarCookie_t, Query_t>::iterator it;
+	for( it = m_Queries.begin(); it != m_Queries.end(); ++it )
+	{
+		if( it->second.index == index )
+			cookies.push_back(it->first);
+	}
+
+	for( unsigned int i = 0; i < cookies.size(); i++ )
+		resolve(cookies[i], object());
+}
+
+void CClientConVarCache::clear()
+{
+	for( int i = 0; i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+		m_Values[i].clear();
+
+	m_Batches.clear();
+	m_Queries.clear();
+}
+
+void CClientConVarCache::process()
+{
+	if( m_Batches.empty() )
+		return;
+
+	// Finished batches are removed first, since the callbacks may start
+	// new queries.
+	double dNow = Plat_FloatTime();
+	std::vector<Batch_t> finished;
+	std::vector<int> expired;
+	for( unsigned int i = 0; i < m_Batches.size(); )
+	{
+		Batch_t& batch = m_Batches[i];
+		if( batch.pending > 0 && batch.deadline > dNow )
+		{
+			i++;
+			continue;
+		}
+
+		if( batch.pending > 0 )
+			expired.push_back(batch.id);
+
+		finished.push_back(batch);
+		m_Batches.erase(m_Batches.begin() + i);
+	}
+
+	for( unsigned int i = 0; i < expired.size(); i++ )
+		cancel(expired[i]);
+
+	for( unsigned int i = 0; i < finished.size(); i++ )
+	{
+		BEGIN_BOOST_PY()
+
+			finished[i].callback(finished[i].results);
+
+		END_BOOST_PY_NORET()
+	}
+}
+
+// ----------------------------------------------------------------------------
+// Exposed functions.
+// ----------------------------------------------------------------------------
+CClientConVarCache* get_client_convar_cache()
+{
+	return &g_ClientConVarCache;
+}
@@ -0,0 +1,122 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _PLAYERS_CONVARS_H
+#define _PLAYERS_CONVARS_H
+
+// ----------------------------------------------------------------------------
+// Includes.
+// ----------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include "const.h"
+#include "edict.h"
+#include "engine/iserverplugin.h"
+#include "boost/unordered_map.hpp"
+#include "utility/wrap_macros.h"
+
+// ----------------------------------------------------------------------------
+// Caches the userinfo convars of all players and runs batched cvar queries.
+//
+// Userinfo values are read from the engine once and kept until the player
+// changes their settings. Queries are sent to many players at once and
+// the callback is called on the next frame after all answers arrived or
+// the timeout expired, with a dict {index: {name: value or None}}.
+// ----------------------------------------------------------------------------
+class CClientConVarCache
+{
+public:
+	CClientConVarCache();
+
+	// Returns the cached userinfo value of the player.
+	object	get_value( int index, const char* name );
+
+	// Returns a dict {value: [indexes]} for the given player indexes.
+	object	group_by_value( object indexes, const char* name );
+
+	// Sends a query for every name to every player and returns the batch id.
+	int		query( object indexes, object names, object callback, float timeout = 5.0 );
+
+	// Drops a batch without calling its callback.
+	void	cancel( int id );
+
+	// Drops the cached values of the player.
+	void	invalidate( int index );
+
+	// Drops the cached values of the player and resolves the pending
+	// answers of the player as None.
+	void	clear_player( int index );
+
+	// Drops all values and batches.
+	void	clear();
+
+	// Called by the engine when a query was answered.
+	void	on_query_finished( QueryCvarCookie_t cookie, EQueryCvarValueStatus status, const char* value );
+
+	// Called once per frame. Resolves finished batches.
+	void	process();
+
+private:
+	struct Batch_t
+	{
+		int		id;
+		int		pending;
+		double	deadline;
+		object	callback;
+		dict	results;
+	};
+
+	struct Query_t
+	{
+		int			batch_id;
+		int			index;
+		std::string	name;
+	};
+
+	bool	is_valid_index( int index );
+	Batch_t* find_batch( int id );
+	void	resolve( QueryCvarCookie_t cookie, object value );
+
+private:
+	int		m_iNextID;
+
+	// Cached userinfo values by player index.
+	boost::unordered_map<std::string, object>	m_Values[ABSOLUTE_PLAYER_LIMIT + 1];
+
+	std::vector<Batch_t>								m_Batches;
+	boost::unordered_map<QueryCvarCookie_t, Query_t>	m_Queries;
+};
+
+// ----------------------------------------------------------------------------
+// Global accessor.
+// ----------------------------------------------------------------------------
+extern CClientConVarCache g_ClientConVarCache;
+
+// ----------------------------------------------------------------------------
+// Exposed functions.
+// ----------------------------------------------------------------------------
+CClientConVarCache* get_client_convar_cache();
+
+#endif // _PLAYERS_CONVARS_H
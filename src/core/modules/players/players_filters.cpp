@@ -0,0 +1,186 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+// ----------------------------------------------------------------------------
+// Includes
+// ----------------------------------------------------------------------------
+#include "players_filters.h"
+#include "utility/sp_util.h"
+
+// ----------------------------------------------------------------------------
+// External variables.
+// ----------------------------------------------------------------------------
+extern CGlobalVars* gpGlobals;
+extern IPlayerInfoManager* playerinfomanager;
+
+// ----------------------------------------------------------------------------
+// Global accessor.
+// ----------------------------------------------------------------------------
+CPlayerFilterMasks g_PlayerFilterMasks;
+
+// ----------------------------------------------------------------------------
+// Exposed functions.
+// ----------------------------------------------------------------------------
+CPlayerFilterMasks* get_player_filter_masks()
+{
+	return &g_PlayerFilterMasks;
+}
+
+// ----------------------------------------------------------------------------
+// CPlayerFilterMasks code.
+// ----------------------------------------------------------------------------
+CPlayerFilterMasks::CPlayerFilterMasks()
+{
+	m_iTickCount = -1;
+	m_bValid = false;
+
+	m_Filters["all"] = &m_All;
+	m_Filters["bot"] = &m_Bots;
+	m_Filters["human"] = &m_Humans;
+	m_Filters["alive"] = &m_Alive;
+	m_Filters["dead"] = &m_Dead;
+	m_Filters["hltv"] = &m_HLTV;
+}
+
+void CPlayerFilterMasks::register_team( const char* name, int team )
+{
+	if( team < 0 || team >= PLAYER_FILTER_MAX_TEAMS )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid team number.")
+
+	m_Filters[name] = &m_Teams[team];
+}
+
+bool CPlayerFilterMasks::has_filter( const char* name )
+{
+	return m_Filters.find(name) != m_Filters.end();
+}
+
+void CPlayerFilterMasks::invalidate()
+{
+	m_bValid = false;
+}
+
+void CPlayerFilterMasks::update()
+{
+	if( m_bValid && m_iTickCount == gpGlobals->tickcount )
+		return;
+
+	m_All.ClearAll();
+	m_Bots.ClearAll();
+	m_Humans.ClearAll();
+	m_HLTV.ClearAll();
+
+	int iMaxClients = gpGlobals->maxClients < ABSOLUTE_PLAYER_LIMIT ? gpGlobals->maxClients : ABSOLUTE_PLAYER_LIMIT;
+	for( int i = 1; i <= iMaxClients; i++ )
+	{
+		IPlayerInfo* pPlayerInfo = PlayerOfIndex(i);
+		if( !pPlayerInfo || !pPlayerInfo->IsConnected() )
+			continue;
+
+		m_All.Set(i);
+
+		// Same as the Python filters, HLTV is a fake client as well.
+		if( pPlayerInfo->IsFakeClient() )
+			m_Bots.Set(i);
+		else
+			m_Humans.Set(i);
+
+		if( pPlayerInfo->IsHLTV() )
+			m_HLTV.Set(i);
+	}
+
+	m_iTickCount = gpGlobals->tickcount;
+	m_bValid = true;
+}
+
+void CPlayerFilterMasks::update_state()
+{
+	m_Alive.ClearAll();
+	m_Dead.ClearAll();
+	for( int i = 0; i < PLAYER_FILTER_MAX_TEAMS; i++ )
+		m_Teams[i].ClearAll();
+
+	for( int i = m_All.FindNextSetBit(1); i != -1; i = m_All.FindNextSetBit(i + 1) )
+	{
+		IPlayerInfo* pPlayerInfo = PlayerOfIndex(i);
+		if( !pPlayerInfo )
+			continue;
+
+		if( pPlayerInfo->IsDead() )
+			m_Dead.Set(i);
+		else
+			m_Alive.Set(i);
+
+		int iTeam = pPlayerInfo->GetTeamIndex();
+		if( iTeam >= 0 && iTeam < PLAYER_FILTER_MAX_TEAMS )
+			m_Teams[iTeam].Set(i);
+	}
+}
+
+bool CPlayerFilterMasks::combine( object filters, CPlayerFilterBits& result, bool bExclude )
+{
+	// A single name is allowed, like in the Python iterators.
+	if( PyUnicode_Check(filters.ptr()) )
+		filters = boost::python::make_tuple(filters);
+
+	for( int i = 0; i < len(filters); i++ )
+	{
+		std::string name = extract<std::string>(filters[i]);
+		boost::unordered_map<std::string, CPlayerFilterBits*>::iterator it = m_Filters.find(name);
+		if( it == m_Filters.end() )
+			return false;
+
+		if( bExclude )
+		{
+			CPlayerFilterBits inverted;
+			it->second->Not(&inverted);
+			result.And(inverted, &result);
+		}
+		else
+		{
+			result.And(*it->second, &result);
+		}
+	}
+
+	return true;
+}
+
+object CPlayerFilterMasks::get_indexes( object is_filters, object not_filters )
+{
+	update();
+	update_state();
+
+	CPlayerFilterBits result;
+	result.Copy(m_All);
+	if( !combine(is_filters, result, false) || !combine(not_filters, result, true) )
+		return object();
+
+	boost::python::list indexes;
+	for( int i = result.FindNextSetBit(1); i != -1; i = result.FindNextSetBit(i + 1) )
+		indexes.append(i);
+
+	return indexes;
+}
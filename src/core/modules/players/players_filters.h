@@ -0,0 +1,99 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _PLAYERS_FILTERS_H
+#define _PLAYERS_FILTERS_H
+
+// ----------------------------------------------------------------------------
+// Includes.
+// ----------------------------------------------------------------------------
+#include <string>
+#include "const.h"
+#include "bitvec.h"
+#include "boost/unordered_map.hpp"
+#include "utility/wrap_macros.h"
+
+// ----------------------------------------------------------------------------
+// Player slot bits. Slot 0 is unused, so player indexes can be used directly.
+// ----------------------------------------------------------------------------
+typedef CBitVec<ABSOLUTE_PLAYER_LIMIT + 1> CPlayerFilterBits;
+
+#define PLAYER_FILTER_MAX_TEAMS 32
+
+// ----------------------------------------------------------------------------
+// Native player filters. The all, bot, human and hltv masks only change when
+// a client (dis)connects, so they are built once per tick or again after that.
+// The alive, dead and team masks can change at any time, e.g. in the middle of
+// a player_death event, so they are read again on every query. Filter
+// combinations are resolved with bitwise ops.
+// ----------------------------------------------------------------------------
+class CPlayerFilterMasks
+{
+public:
+	CPlayerFilterMasks();
+
+	// Adds a filter that matches the players of the team.
+	void	register_team( const char* name, int team );
+
+	// Returns whether the filter is resolved natively.
+	bool	has_filter( const char* name );
+
+	// Returns the indexes of the players that pass all is_filters and none of
+	// the not_filters, or None if one of the filters isn't native.
+	object	get_indexes( object is_filters, object not_filters );
+
+	// Makes the next query rebuild the connection masks.
+	void	invalidate();
+
+private:
+	void	update();
+	void	update_state();
+	bool	combine( object filters, CPlayerFilterBits& result, bool bExclude );
+
+private:
+	int					m_iTickCount;
+	bool				m_bValid;
+	CPlayerFilterBits	m_All;
+	CPlayerFilterBits	m_Bots;
+	CPlayerFilterBits	m_Humans;
+	CPlayerFilterBits	m_Alive;
+	CPlayerFilterBits	m_Dead;
+	CPlayerFilterBits	m_HLTV;
+	CPlayerFilterBits	m_Teams[PLAYER_FILTER_MAX_TEAMS];
+
+	boost::unordered_map<std::string, CPlayerFilterBits*>	m_Filters;
+};
+
+// ----------------------------------------------------------------------------
+// Global accessor.
+// ----------------------------------------------------------------------------
+extern CPlayerFilterMasks g_PlayerFilterMasks;
+
+// ----------------------------------------------------------------------------
+// Exposed functions.
+// ----------------------------------------------------------------------------
+CPlayerFilterMasks* get_player_filter_masks();
+
+#endif // _PLAYERS_FILTERS_H
@@ -29,6 +29,7 @@
 // ----------------------------------------------------------------------------
 #include "players_generator_wrap.h"
 #include "players_wrap.h"
+#include "players_cache.h"
 #include "utility/sp_util.h"
 #include "game/server/iplayerinfo.h"
 #include "boost/python/iterator.hpp"
@@ -66,20 +67,16 @@ CPlayerGenerator::~CPlayerGenerator()
 // ----------------------------------------------------------------------------
 // Returns the next valid CPlayerInfo instance.
 // ----------------------------------------------------------------------------
-CPlayerInfo* CPlayerGenerator::getNext()
+object CPlayerGenerator::getNext()
 {
-	IPlayerInfo* pIPlayerInfo = NULL;
-	CPlayerInfo* pPlayerInfo = NULL;
 	while(m_iEntityIndex < gpGlobals->maxClients)
 	{
 		m_iEntityIndex++;
-		edict_t* pEdict = PEntityOfEntIndex(m_iEntityIndex);
-		pIPlayerInfo = playerinfomanager->GetPlayerInfo(pEdict);
-		if ( pIPlayerInfo )
+		object playerinfo = g_PlayerInfoCache.get_player_info(m_iEntityIndex);
+		if ( !playerinfo.is_none() )
 		{
-			pPlayerInfo = new CPlayerInfo(pIPlayerInfo);
-			return pPlayerInfo;
+			return playerinfo;
 		}
 	}
-	return NULL;
+	return object();
 }
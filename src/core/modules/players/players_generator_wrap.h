@@ -49,7 +49,7 @@ public:
 	virtual ~CPlayerGenerator();
 
 protected:
-	virtual CPlayerInfo* getNext();
+	virtual object getNext();
 
 private:
 	int m_iEntityIndex;
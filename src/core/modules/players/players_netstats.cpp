@@ -0,0 +1,271 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+// ----------------------------------------------------------------------------
+// Includes
+// ----------------------------------------------------------------------------
+#include <algorithm>
+#include "players_netstats.h"
+#include "inetchannelinfo.h"
+#include "utility/sp_util.h"
+
+// ----------------------------------------------------------------------------
+// External variables.
+// ----------------------------------------------------------------------------
+extern CGlobalVars* gpGlobals;
+
+// ----------------------------------------------------------------------------
+// Static singletons.
+// ----------------------------------------------------------------------------
+static CNetChannelSampler s_NetChannelSampler;
+
+// ----------------------------------------------------------------------------
+// NetChannelSampler accessor.
+// ----------------------------------------------------------------------------
+CNetChannelSampler* get_net_channel_sampler()
+{
+	return &s_NetChannelSampler;
+}
+
+// ----------------------------------------------------------------------------
+// CNetChannelSampler code.
+// ----------------------------------------------------------------------------
+CNetChannelSampler::CNetChannelSampler()
+{
+	m_iInterval = 0;
+	m_iTicks = 0;
+	m_iNextID = 1;
+}
+
+void CNetChannelSampler::set_interval( int ticks )
+{
+	m_iInterval = ticks > 0 ? ticks : 0;
+	m_iTicks = 0;
+
+	// The buffers are only allocated once sampling is used.
+	if( m_iInterval && m_Players.empty() )
+	{
+		m_Players.resize(ABSOLUTE_PLAYER_LIMIT + 1);
+		for( int i = 0; i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+			clear_player(i);
+	}
+}
+
+int CNetChannelSampler::get_interval()
+{
+	return m_iInterval;
+}
+
+void CNetChannelSampler::check_index( int player_index )
+{
+	if( player_index <= 0 || player_index > ABSOLUTE_PLAYER_LIMIT )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index.")
+}
+
+int CNetChannelSampler::get_sample_count( int player_index )
+{
+	check_index(player_index);
+	return m_Players.empty() ? 0 : m_Players[player_index].count;
+}
+
+float CNetChannelSampler::get_latest( int player_index, NetStatMetric metric )
+{
+	if( get_sample_count(player_index) == 0 )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Player has no samples.")
+
+	const PlayerSamples_t& samples = m_Players[player_index];
+	return samples.values[metric][(samples.next + NETSTAT_HISTORY - 1) % NETSTAT_HISTORY];
+}
+
+object CNetChannelSampler::get_stats( int player_index, NetStatMetric metric, int window /* = 0 */ )
+{
+	if( get_sample_count(player_index) == 0 )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Player has no samples.")
+
+	return boost::python::make_tuple(
+		aggregate(player_index, metric, NETSTAT_AVG, window),
+		aggregate(player_index, metric, NETSTAT_P95, window),
+		aggregate(player_index, metric, NETSTAT_MAX, window)
+	);
+}
+
+int CNetChannelSampler::get_window( const PlayerSamples_t& samples, int window, float* pValues, NetStatMetric metric )
+{
+	if( window <= 0 || window > samples.count )
+		window = samples.count;
+
+	for( int i = 0; i < window; i++ )
+		pValues[i] = samples.values[metric][(samples.next + NETSTAT_HISTORY - 1 - i) % NETSTAT_HISTORY];
+
+	return window;
+}
+
+float CNetChannelSampler::aggregate( int player_index, NetStatMetric metric, NetStatAggregate aggregate, int window )
+{
+	float values[NETSTAT_HISTORY];
+	int iCount = get_window(m_Players[player_index], window, values, metric);
+	if( !iCount )
+		return 0;
+
+	switch( aggregate )
+	{
+		case NETSTAT_P95:
+		{
+			// Nearest rank of the 95th percentile.
+			int iRank = (95 * iCount + 99) / 100 - 1;
+			std::nth_element(values, values + iRank, values + iCount);
+			return values[iRank];
+		}
+
+		case NETSTAT_MAX:
+			return *std::max_element(values, values + iCount);
+	}
+
+	float flSum = 0;
+	for( int i = 0; i < iCount; i++ )
+		flSum += values[i];
+
+	return flSum / iCount;
+}
+
+int CNetChannelSampler::add_threshold( NetStatMetric metric, float value, object callback,
+	NetStatAggregate aggregate /* = NETSTAT_AVG */, int window /* = 1 */ )
+{
+	if( !PyCallable_Check(callback.ptr()) )
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Callback is not callable.")
+
+	if( window <= 0 || window > NETSTAT_HISTORY )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid window.")
+
+	Threshold_t threshold;
+	threshold.id = m_iNextID++;
+	threshold.metric = metric;
+	threshold.value = value;
+	threshold.callback = callback;
+	threshold.aggregate = aggregate;
+	threshold.window = window;
+	threshold.exceeded.ClearAll();
+
+	m_Thresholds.push_back(threshold);
+	return threshold.id;
+}
+
+void CNetChannelSampler::remove_threshold( int id )
+{
+	for( std::vector<Threshold_t>::iterator it = m_Thresholds.begin(); it != m_Thresholds.end(); ++it )
+	{
+		if( it->id == id )
+		{
+			m_Thresholds.erase(it);
+			return;
+		}
+	}
+}
+
+void CNetChannelSampler::clear_player( int player_index )
+{
+	if( player_index < 0 || player_index > ABSOLUTE_PLAYER_LIMIT )
+		return;
+
+	for( unsigned int i = 0; i < m_Thresholds.size(); i++ )
+		m_Thresholds[i].exceeded.Clear(player_index);
+
+	if( m_Players.empty() )
+		return;
+
+	m_Players[player_index].count = 0;
+	m_Players[player_index].next = 0;
+}
+
+void CNetChannelSampler::clear()
+{
+	m_Thresholds.clear();
+	for( int i = 0; i <= ABSOLUTE_PLAYER_LIMIT && !m_Players.empty(); i++ )
+		clear_player(i);
+}
+
+void CNetChannelSampler::process()
+{
+	if( !m_iInterval || ++m_iTicks < m_iInterval )
+		return;
+
+	m_iTicks = 0;
+
+	// Alerts are collected first, since the callbacks may change the thresholds.
+	std::vector<object> callbacks;
+	std::vector<boost::python::tuple> alerts;
+
+	int iMaxClients = gpGlobals->maxClients < ABSOLUTE_PLAYER_LIMIT ? gpGlobals->maxClients : ABSOLUTE_PLAYER_LIMIT;
+	for( int i = 1; i <= iMaxClients; i++ )
+	{
+		// Bots have no network channel.
+		INetChannelInfo* pNetInfo = engine->GetPlayerNetInfo(i);
+		if( !pNetInfo )
+			continue;
+
+		PlayerSamples_t& samples = m_Players[i];
+		samples.values[NETSTAT_LATENCY][samples.next] = pNetInfo->GetLatency(FLOW_OUTGOING);
+		samples.values[NETSTAT_LOSS][samples.next] = pNetInfo->GetAvgLoss(FLOW_INCOMING);
+		samples.values[NETSTAT_CHOKE][samples.next] = pNetInfo->GetAvgChoke(FLOW_OUTGOING);
+		samples.values[NETSTAT_IN_RATE][samples.next] = pNetInfo->GetAvgData(FLOW_INCOMING);
+		samples.values[NETSTAT_OUT_RATE][samples.next] = pNetInfo->GetAvgData(FLOW_OUTGOING);
+		samples.next = (samples.next + 1) % NETSTAT_HISTORY;
+		if( samples.count < NETSTAT_HISTORY )
+			samples.count++;
+
+		for( unsigned int j = 0; j < m_Thresholds.size(); j++ )
+		{
+			Threshold_t& threshold = m_Thresholds[j];
+
+			// A partial window would alert on a single spike after connecting.
+			if( samples.count < threshold.window )
+				continue;
+
+			float flValue = aggregate(i, threshold.metric, threshold.aggregate, threshold.window);
+			if( flValue <= threshold.value )
+			{
+				threshold.exceeded.Clear(i);
+				continue;
+			}
+
+			if( threshold.exceeded.IsBitSet(i) )
+				continue;
+
+			threshold.exceeded.Set(i);
+			callbacks.push_back(threshold.callback);
+			alerts.push_back(boost::python::make_tuple(i, threshold.metric, flValue));
+		}
+	}
+
+	for( unsigned int i = 0; i < callbacks.size(); i++ )
+	{
+		BEGIN_BOOST_PY()
+
+			object result(handle<>(PyObject_CallObject(callbacks[i].ptr(), alerts[i].ptr())));
+
+		END_BOOST_PY_NORET()
+	}
+}
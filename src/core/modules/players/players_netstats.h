@@ -0,0 +1,141 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _PLAYERS_NETSTATS_H
+#define _PLAYERS_NETSTATS_H
+
+// ----------------------------------------------------------------------------
+// Includes.
+// ----------------------------------------------------------------------------
+#include <vector>
+#include "const.h"
+#include "bitvec.h"
+#include "utility/wrap_macros.h"
+
+// ----------------------------------------------------------------------------
+// Number of samples kept per player and metric.
+// ----------------------------------------------------------------------------
+#define NETSTAT_HISTORY 64
+
+// ----------------------------------------------------------------------------
+// Sampled INetChannelInfo values.
+// ----------------------------------------------------------------------------
+enum NetStatMetric
+{
+	NETSTAT_LATENCY = 0,	// Outgoing latency in seconds.
+	NETSTAT_LOSS,			// Average incoming packet loss [0..1].
+	NETSTAT_CHOKE,			// Average outgoing packet choke [0..1].
+	NETSTAT_IN_RATE,		// Average incoming data in bytes/sec.
+	NETSTAT_OUT_RATE,		// Average outgoing data in bytes/sec.
+
+	NETSTAT_METRIC_COUNT
+};
+
+// ----------------------------------------------------------------------------
+// Aggregates over a window of samples.
+// ----------------------------------------------------------------------------
+enum NetStatAggregate
+{
+	NETSTAT_AVG = 0,
+	NETSTAT_P95,
+	NETSTAT_MAX
+};
+
+// ----------------------------------------------------------------------------
+// Native network channel sampler. Every N ticks the metrics of all human
+// players are written into fixed ring buffers. Thresholds are checked in
+// C++ and only call Python when a player's aggregate goes above one.
+// ----------------------------------------------------------------------------
+class CNetChannelSampler
+{
+public:
+	CNetChannelSampler();
+
+	// Samples every given number of ticks. 0 stops sampling.
+	void	set_interval( int ticks );
+	int		get_interval();
+
+	// Returns the number of samples of the player.
+	int		get_sample_count( int player_index );
+
+	// Returns the newest sample of the metric.
+	float	get_latest( int player_index, NetStatMetric metric );
+
+	// Returns (avg, p95, max) over the newest window samples. A window of 0
+	// uses all samples.
+	object	get_stats( int player_index, NetStatMetric metric, int window = 0 );
+
+	// Calls callback(index, metric, value) when the aggregate over the window
+	// goes above the value. It's called again after the aggregate dropped
+	// below the value. Players with less than window samples are skipped.
+	// Returns the id of the threshold.
+	int		add_threshold( NetStatMetric metric, float value, object callback,
+				NetStatAggregate aggregate = NETSTAT_AVG, int window = 1 );
+
+	void	remove_threshold( int id );
+
+	// Drops the samples of a player.
+	void	clear_player( int player_index );
+
+	// Drops all samples and thresholds.
+	void	clear();
+
+	// Called once per frame.
+	void	process();
+
+private:
+	struct Threshold_t
+	{
+		int						id;
+		NetStatMetric			metric;
+		float					value;
+		object					callback;
+		NetStatAggregate		aggregate;
+		int						window;
+		CBitVec<ABSOLUTE_PLAYER_LIMIT + 1>	exceeded;
+	};
+
+	struct PlayerSamples_t
+	{
+		int		count;
+		int		next;
+		float	values[NETSTAT_METRIC_COUNT][NETSTAT_HISTORY];
+	};
+
+	void	check_index( int player_index );
+	float	aggregate( int player_index, NetStatMetric metric, NetStatAggregate aggregate, int window );
+	int		get_window( const PlayerSamples_t& samples, int window, float* pValues, NetStatMetric metric );
+
+private:
+	int								m_iInterval;
+	int								m_iTicks;
+	int								m_iNextID;
+	std::vector<PlayerSamples_t>	m_Players;
+	std::vector<Threshold_t>		m_Thresholds;
+};
+
+CNetChannelSampler* get_net_channel_sampler();
+
+#endif // _PLAYERS_NETSTATS_H
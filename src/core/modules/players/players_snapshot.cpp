@@ -0,0 +1,235 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+// ----------------------------------------------------------------------------
+// Includes
+// ----------------------------------------------------------------------------
+#include <cstring>
+#include "players_snapshot.h"
+#include "utility/sp_util.h"
+
+// ----------------------------------------------------------------------------
+// External variables.
+// ----------------------------------------------------------------------------
+extern CGlobalVars* gpGlobals;
+extern IPlayerInfoManager* playerinfomanager;
+
+// ----------------------------------------------------------------------------
+// Global accessor.
+// ----------------------------------------------------------------------------
+CPlayerSnapshot g_PlayerSnapshot;
+
+// ----------------------------------------------------------------------------
+// Exposed functions.
+// ----------------------------------------------------------------------------
+CPlayerSnapshot* get_player_snapshot( int fields )
+{
+	g_PlayerSnapshot.update(fields);
+	return &g_PlayerSnapshot;
+}
+
+// ----------------------------------------------------------------------------
+// CPlayerSnapshot code.
+// ----------------------------------------------------------------------------
+CPlayerSnapshot::CPlayerSnapshot()
+{
+	m_iFields = 0;
+	memset(m_Valid, 0, sizeof(m_Valid));
+	memset(m_Origins, 0, sizeof(m_Origins));
+	memset(m_Angles, 0, sizeof(m_Angles));
+	memset(m_Health, 0, sizeof(m_Health));
+	memset(m_Armor, 0, sizeof(m_Armor));
+	memset(m_Teams, 0, sizeof(m_Teams));
+	memset(m_Alive, 0, sizeof(m_Alive));
+}
+
+void CPlayerSnapshot::update( int fields )
+{
+	m_iFields = fields & SNAPSHOT_ALL;
+
+	bool bWeapons = (m_iFields & SNAPSHOT_WEAPON) != 0;
+	object weapons = bWeapons ? get_weapons() : object();
+
+	int iMaxClients = gpGlobals->maxClients < ABSOLUTE_PLAYER_LIMIT ? gpGlobals->maxClients : ABSOLUTE_PLAYER_LIMIT;
+	for( int i = 1; i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+	{
+		IPlayerInfo* pPlayerInfo = NULL;
+		if( i <= iMaxClients )
+		{
+			edict_t* pEdict = PEntityOfEntIndex(i);
+			if( pEdict && !pEdict->IsFree() )
+				pPlayerInfo = playerinfomanager->GetPlayerInfo(pEdict);
+
+			if( pPlayerInfo && !pPlayerInfo->IsConnected() )
+				pPlayerInfo = NULL;
+		}
+
+		m_Valid[i] = pPlayerInfo != NULL;
+		if( !pPlayerInfo )
+		{
+			// Empty slots are zeroed in the requested columns.
+			if( m_iFields & SNAPSHOT_ORIGIN )
+				m_Origins[i][0] = m_Origins[i][1] = m_Origins[i][2] = 0;
+
+			if( m_iFields & SNAPSHOT_ANGLES )
+				m_Angles[i][0] = m_Angles[i][1] = m_Angles[i][2] = 0;
+
+			if( m_iFields & SNAPSHOT_HEALTH )
+				m_Health[i] = 0;
+
+			if( m_iFields & SNAPSHOT_ARMOR )
+				m_Armor[i] = 0;
+
+			if( m_iFields & SNAPSHOT_TEAM )
+				m_Teams[i] = 0;
+
+			if( m_iFields & SNAPSHOT_ALIVE )
+				m_Alive[i] = 0;
+
+			if( bWeapons )
+				weapons[i] = object();
+
+			continue;
+		}
+
+		if( m_iFields & SNAPSHOT_ORIGIN )
+		{
+			Vector vecOrigin = pPlayerInfo->GetAbsOrigin();
+			m_Origins[i][0] = vecOrigin.x;
+			m_Origins[i][1] = vecOrigin.y;
+			m_Origins[i][2] = vecOrigin.z;
+		}
+
+		if( m_iFields & SNAPSHOT_ANGLES )
+		{
+			QAngle angAngles = pPlayerInfo->GetAbsAngles();
+			m_Angles[i][0] = angAngles.x;
+			m_Angles[i][1] = angAngles.y;
+			m_Angles[i][2] = angAngles.z;
+		}
+
+		if( m_iFields & SNAPSHOT_HEALTH )
+			m_Health[i] = pPlayerInfo->GetHealth();
+
+		if( m_iFields & SNAPSHOT_ARMOR )
+			m_Armor[i] = pPlayerInfo->GetArmorValue();
+
+		if( m_iFields & SNAPSHOT_TEAM )
+			m_Teams[i] = pPlayerInfo->GetTeamIndex();
+
+		if( m_iFields & SNAPSHOT_ALIVE )
+			m_Alive[i] = !pPlayerInfo->IsDead();
+
+		if( bWeapons )
+			weapons[i] = get_weapon_name(pPlayerInfo->GetWeaponName());
+	}
+}
+
+int CPlayerSnapshot::get_fields()
+{
+	return m_iFields;
+}
+
+object CPlayerSnapshot::get_view( object& view, void* pBuffer, int iSize, const char* szFormat )
+{
+	if( view.is_none() )
+	{
+		object bytes_view(handle<>(PyMemoryView_FromMemory((char *) pBuffer, iSize, PyBUF_READ)));
+		view = bytes_view.attr("cast")(szFormat);
+	}
+
+	return view;
+}
+
+object CPlayerSnapshot::get_valid()
+{
+	return get_view(m_ValidView, m_Valid, sizeof(m_Valid), "B");
+}
+
+object CPlayerSnapshot::get_origins()
+{
+	return get_view(m_OriginsView, m_Origins, sizeof(m_Origins), "f");
+}
+
+object CPlayerSnapshot::get_angles()
+{
+	return get_view(m_AnglesView, m_Angles, sizeof(m_Angles), "f");
+}
+
+object CPlayerSnapshot::get_health()
+{
+	return get_view(m_HealthView, m_Health, sizeof(m_Health), "i");
+}
+
+object CPlayerSnapshot::get_armor()
+{
+	return get_view(m_ArmorView, m_Armor, sizeof(m_Armor), "i");
+}
+
+object CPlayerSnapshot::get_teams()
+{
+	return get_view(m_TeamsView, m_Teams, sizeof(m_Teams), "i");
+}
+
+object CPlayerSnapshot::get_alive()
+{
+	return get_view(m_AliveView, m_Alive, sizeof(m_Alive), "B");
+}
+
+object CPlayerSnapshot::get_weapons()
+{
+	if( m_Weapons.is_none() )
+		m_Weapons = boost::python::list(boost::python::make_tuple(object()) * (ABSOLUTE_PLAYER_LIMIT + 1));
+
+	return m_Weapons;
+}
+
+object CPlayerSnapshot::get_weapon_name( const char* szName )
+{
+	if( !szName || !*szName )
+		return object();
+
+	boost::unordered_map<std::string, object>::iterator it = m_WeaponNames.find(szName);
+	if( it != m_WeaponNames.end() )
+		return it->second;
+
+	object name(szName);
+	m_WeaponNames[szName] = name;
+	return name;
+}
+
+void CPlayerSnapshot::clear()
+{
+	m_ValidView = object();
+	m_OriginsView = object();
+	m_AnglesView = object();
+	m_HealthView = object();
+	m_ArmorView = object();
+	m_TeamsView = object();
+	m_AliveView = object();
+	m_Weapons = object();
+	m_WeaponNames.clear();
+}
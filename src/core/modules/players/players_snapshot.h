@@ -0,0 +1,129 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _PLAYERS_SNAPSHOT_H
+#define _PLAYERS_SNAPSHOT_H
+
+// ----------------------------------------------------------------------------
+// Includes.
+// ----------------------------------------------------------------------------
+#include <string>
+#include "const.h"
+#include "boost/unordered_map.hpp"
+#include "utility/wrap_macros.h"
+
+// ----------------------------------------------------------------------------
+// Columns of the player snapshot. They can be combined.
+// ----------------------------------------------------------------------------
+enum PlayerSnapshotField
+{
+	SNAPSHOT_ORIGIN = (1 << 0),
+	SNAPSHOT_ANGLES = (1 << 1),
+	SNAPSHOT_HEALTH = (1 << 2),
+	SNAPSHOT_ARMOR = (1 << 3),
+	SNAPSHOT_TEAM = (1 << 4),
+	SNAPSHOT_ALIVE = (1 << 5),
+	SNAPSHOT_WEAPON = (1 << 6),
+
+	SNAPSHOT_ALL = (1 << 7) - 1
+};
+
+// ----------------------------------------------------------------------------
+// Struct of arrays snapshot of all player slots. The columns are fixed
+// buffers indexed by player index, exposed to Python as memoryviews, so
+// reading every player's state costs one call instead of one per value.
+// Only the requested columns are filled; the others keep their last values.
+// ----------------------------------------------------------------------------
+class CPlayerSnapshot
+{
+public:
+	CPlayerSnapshot();
+
+	// Fills the requested columns for all slots.
+	void	update( int fields );
+
+	// Fields filled by the last update.
+	int		get_fields();
+
+	// One byte per slot. 1 if the slot had a connected player.
+	object	get_valid();
+
+	// Three floats per slot.
+	object	get_origins();
+	object	get_angles();
+
+	// One int per slot.
+	object	get_health();
+	object	get_armor();
+	object	get_teams();
+
+	// One byte per slot.
+	object	get_alive();
+
+	// A list with the weapon name of every slot or None.
+	object	get_weapons();
+
+	// Drops all Python objects.
+	void	clear();
+
+private:
+	object	get_view( object& view, void* pBuffer, int iSize, const char* szFormat );
+	object	get_weapon_name( const char* szName );
+
+private:
+	int				m_iFields;
+	unsigned char	m_Valid[ABSOLUTE_PLAYER_LIMIT + 1];
+	float			m_Origins[ABSOLUTE_PLAYER_LIMIT + 1][3];
+	float			m_Angles[ABSOLUTE_PLAYER_LIMIT + 1][3];
+	int				m_Health[ABSOLUTE_PLAYER_LIMIT + 1];
+	int				m_Armor[ABSOLUTE_PLAYER_LIMIT + 1];
+	int				m_Teams[ABSOLUTE_PLAYER_LIMIT + 1];
+	unsigned char	m_Alive[ABSOLUTE_PLAYER_LIMIT + 1];
+
+	// Views are created once, since the buffers never move.
+	object			m_ValidView;
+	object			m_OriginsView;
+	object			m_AnglesView;
+	object			m_HealthView;
+	object			m_ArmorView;
+	object			m_TeamsView;
+	object			m_AliveView;
+	object			m_Weapons;
+
+	// Weapon names are shared by all players, so the str objects are reused.
+	boost::unordered_map<std::string, object>	m_WeaponNames;
+};
+
+// ----------------------------------------------------------------------------
+// Global accessor.
+// ----------------------------------------------------------------------------
+extern CPlayerSnapshot g_PlayerSnapshot;
+
+// ----------------------------------------------------------------------------
+// Exposed functions.
+// ----------------------------------------------------------------------------
+CPlayerSnapshot* get_player_snapshot( int fields );
+
+#endif // _PLAYERS_SNAPSHOT_H
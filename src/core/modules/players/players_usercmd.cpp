@@ -0,0 +1,501 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+// ----------------------------------------------------------------------------
+// Includes
+// ----------------------------------------------------------------------------
+#include "players_usercmd.h"
+#include "cpp_manager.h"
+#include "modules/memory/memory_hooks.h"
+#include "utility/sp_util.h"
+
+// ----------------------------------------------------------------------------
+// External variables.
+// ----------------------------------------------------------------------------
+extern CGlobalVars* gpGlobals;
+
+// ----------------------------------------------------------------------------
+// Static singletons.
+// ----------------------------------------------------------------------------
+static CUserCmdManager s_UserCmdManager;
+
+// ----------------------------------------------------------------------------
+// UserCmdManager accessor.
+// ----------------------------------------------------------------------------
+CUserCmdManager* get_usercmd_manager()
+{
+	return &s_UserCmdManager;
+}
+
+// ----------------------------------------------------------------------------
+// void CBasePlayer::PlayerRunCommand(CUserCmd*, IMoveHelper*)
+// ----------------------------------------------------------------------------
+HookRetBuf_t* PlayerRunCommandPre( CDetour* pDetour )
+{
+	void* pPlayer = *(void **) GetArgumentAddress(pDetour, 0);
+	void* pCommand = *(void **) GetArgumentAddress(pDetour, 1);
+	s_UserCmdManager.run_command(pPlayer, pCommand);
+
+	HookRetBuf_t* buffer = new HookRetBuf_t;
+	buffer->eRes = HOOKRES_NONE;
+	buffer->pRetBuf = NULL;
+	return buffer;
+}
+
+// ----------------------------------------------------------------------------
+// CUserCmdView code.
+// ----------------------------------------------------------------------------
+CUserCmdView::CUserCmdView( void* pCommand, const int* pOffsets )
+{
+	m_pCommand = pCommand;
+	m_pOffsets = pOffsets;
+}
+
+int CUserCmdView::get_command_number()
+{
+	return *get_field<int>(USERCMD_COMMAND_NUMBER);
+}
+
+int CUserCmdView::get_tick_count()
+{
+	return *get_field<int>(USERCMD_TICK_COUNT);
+}
+
+QAngle CUserCmdView::get_view_angles()
+{
+	return *get_field<QAngle>(USERCMD_VIEW_ANGLES);
+}
+
+void CUserCmdView::set_view_angles( QAngle angles )
+{
+	*get_field<QAngle>(USERCMD_VIEW_ANGLES) = angles;
+}
+
+float CUserCmdView::get_forward_move()
+{
+	return *get_field<float>(USERCMD_FORWARD_MOVE);
+}
+
+void CUserCmdView::set_forward_move( float value )
+{
+	*get_field<float>(USERCMD_FORWARD_MOVE) = value;
+}
+
+float CUserCmdView::get_side_move()
+{
+	return *get_field<float>(USERCMD_SIDE_MOVE);
+}
+
+void CUserCmdView::set_side_move( float value )
+{
+	*get_field<float>(USERCMD_SIDE_MOVE) = value;
+}
+
+float CUserCmdView::get_up_move()
+{
+	return *get_field<float>(USERCMD_UP_MOVE);
+}
+
+void CUserCmdView::set_up_move( float value )
+{
+	*get_field<float>(USERCMD_UP_MOVE) = value;
+}
+
+int CUserCmdView::get_buttons()
+{
+	return *get_field<int>(USERCMD_BUTTONS);
+}
+
+void CUserCmdView::set_buttons( int value )
+{
+	*get_field<int>(USERCMD_BUTTONS) = value;
+}
+
+int CUserCmdView::get_impulse()
+{
+	return *get_field<unsigned char>(USERCMD_IMPULSE);
+}
+
+void CUserCmdView::set_impulse( int value )
+{
+	*get_field<unsigned char>(USERCMD_IMPULSE) = (unsigned char) value;
+}
+
+int CUserCmdView::get_weapon_select()
+{
+	return *get_field<int>(USERCMD_WEAPON_SELECT);
+}
+
+void CUserCmdView::set_weapon_select( int value )
+{
+	*get_field<int>(USERCMD_WEAPON_SELECT) = value;
+}
+
+int CUserCmdView::get_weapon_subtype()
+{
+	return *get_field<int>(USERCMD_WEAPON_SUBTYPE);
+}
+
+void CUserCmdView::set_weapon_subtype( int value )
+{
+	*get_field<int>(USERCMD_WEAPON_SUBTYPE) = value;
+}
+
+int CUserCmdView::get_random_seed()
+{
+	return *get_field<int>(USERCMD_RANDOM_SEED);
+}
+
+int CUserCmdView::get_mouse_dx()
+{
+	return *get_field<short>(USERCMD_MOUSE_DX);
+}
+
+int CUserCmdView::get_mouse_dy()
+{
+	return *get_field<short>(USERCMD_MOUSE_DY);
+}
+
+unsigned long CUserCmdView::get_pointer()
+{
+	return (unsigned long) get_command();
+}
+
+void CUserCmdView::invalidate()
+{
+	m_pCommand = NULL;
+}
+
+void* CUserCmdView::get_command()
+{
+	if( !m_pCommand )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "The command is only valid during the callback.")
+
+	return m_pCommand;
+}
+
+// ----------------------------------------------------------------------------
+// CUserCmdManager code.
+// ----------------------------------------------------------------------------
+CUserCmdManager::CUserCmdManager()
+{
+	m_pRunCommand = NULL;
+	m_bHooked = false;
+	m_iOverrideCount = 0;
+
+	for( int i = 0; i < USERCMD_FIELD_COUNT; i++ )
+		m_Offsets[i] = -1;
+
+	for( int i = 0; i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+	{
+		m_Overrides[i].active = false;
+		m_Overrides[i].fields = 0;
+		m_Overrides[i].add_buttons = 0;
+		m_Overrides[i].remove_buttons = 0;
+	}
+}
+
+void CUserCmdManager::set_run_command_function( object pointer )
+{
+	// The detour can't be moved once it was created.
+	if( m_bHooked )
+		return;
+
+	m_pRunCommand = (void *) ExtractPyPtr(pointer);
+}
+
+void CUserCmdManager::set_field_offset( UserCmdField field, int offset )
+{
+	if( field < 0 || field >= USERCMD_FIELD_COUNT )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid field.")
+
+	m_Offsets[field] = offset;
+}
+
+bool CUserCmdManager::install_hook()
+{
+	if( m_bHooked )
+		return true;
+
+	if( !m_pRunCommand )
+		return false;
+
+	for( int i = 0; i < USERCMD_FIELD_COUNT; i++ )
+	{
+		if( m_Offsets[i] < 0 )
+			BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "CUserCmd offsets are not set.")
+	}
+
+	m_bHooked = CPP_CreateCallback(m_pRunCommand, CONV_THISCALL, "pp)v", &PlayerRunCommandPre, TYPE_PRE);
+	return m_bHooked;
+}
+
+bool CUserCmdManager::is_valid_field( UserCmdField field )
+{
+	switch( field )
+	{
+		case USERCMD_FORWARD_MOVE:
+		case USERCMD_SIDE_MOVE:
+		case USERCMD_UP_MOVE:
+		case USERCMD_IMPULSE:
+		case USERCMD_WEAPON_SELECT:
+		case USERCMD_WEAPON_SUBTYPE:
+			return true;
+	}
+
+	return false;
+}
+
+void CUserCmdManager::set_callback( object callback )
+{
+	if( !callback.is_none() )
+	{
+		if( !PyCallable_Check(callback.ptr()) )
+			BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Callback is not callable.")
+
+		if( !install_hook() )
+			BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Failed to hook PlayerRunCommand.")
+	}
+
+	m_Callback = callback;
+}
+
+void CUserCmdManager::set_batch_callback( object callback )
+{
+	if( !callback.is_none() )
+	{
+		if( !PyCallable_Check(callback.ptr()) )
+			BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Callback is not callable.")
+
+		if( !install_hook() )
+			BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Failed to hook PlayerRunCommand.")
+	}
+	else
+	{
+		m_Batch.clear();
+	}
+
+	m_BatchCallback = callback;
+}
+
+void CUserCmdManager::set_override( int player_index, UserCmdField field, float value )
+{
+	if( player_index <= 0 || player_index > ABSOLUTE_PLAYER_LIMIT )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index.")
+
+	if( !is_valid_field(field) )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Field can't be overridden.")
+
+	if( !install_hook() )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Failed to hook PlayerRunCommand.")
+
+	PlayerOverrides_t& overrides = m_Overrides[player_index];
+	overrides.fields |= (1 << field);
+	overrides.values[field] = value;
+	update_overrides(player_index);
+}
+
+void CUserCmdManager::remove_override( int player_index, UserCmdField field )
+{
+	if( player_index <= 0 || player_index > ABSOLUTE_PLAYER_LIMIT )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index.")
+
+	if( field < 0 || field >= USERCMD_FIELD_COUNT )
+		return;
+
+	m_Overrides[player_index].fields &= ~(1 << field);
+	update_overrides(player_index);
+}
+
+void CUserCmdManager::set_buttons( int player_index, int add_buttons, int remove_buttons )
+{
+	if( player_index <= 0 || player_index > ABSOLUTE_PLAYER_LIMIT )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index.")
+
+	if( (add_buttons || remove_buttons) && !install_hook() )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Failed to hook PlayerRunCommand.")
+
+	PlayerOverrides_t& overrides = m_Overrides[player_index];
+	overrides.add_buttons = add_buttons;
+	overrides.remove_buttons = remove_buttons;
+	update_overrides(player_index);
+}
+
+void CUserCmdManager::clear_player( int player_index )
+{
+	if( player_index < 0 || player_index > ABSOLUTE_PLAYER_LIMIT )
+		return;
+
+	PlayerOverrides_t& overrides = m_Overrides[player_index];
+	overrides.fields = 0;
+	overrides.add_buttons = 0;
+	overrides.remove_buttons = 0;
+	update_overrides(player_index);
+}
+
+void CUserCmdManager::update_overrides( int player_index )
+{
+	PlayerOverrides_t& overrides = m_Overrides[player_index];
+	bool bActive = overrides.fields || overrides.add_buttons || overrides.remove_buttons;
+	if( bActive == overrides.active )
+		return;
+
+	overrides.active = bActive;
+	m_iOverrideCount += bActive ? 1 : -1;
+}
+
+void CUserCmdManager::clear_batch()
+{
+	m_Batch.clear();
+}
+
+void CUserCmdManager::clear()
+{
+	for( int i = 0; i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+		clear_player(i);
+
+	m_Callback = object();
+	m_BatchCallback = object();
+	m_Batch.clear();
+}
+
+void CUserCmdManager::process()
+{
+	if( m_Batch.empty() )
+		return;
+
+	// The callback may run commands itself, so the batch is swapped out first.
+	std::vector<UserCmdRecord_t> batch;
+	batch.swap(m_Batch);
+
+	object callback = m_BatchCallback;
+	if( callback.is_none() )
+		return;
+
+	BEGIN_BOOST_PY()
+
+		object buffer(handle<>(PyBytes_FromStringAndSize((const char *) &batch[0], batch.size() * sizeof(UserCmdRecord_t))));
+		callback(buffer);
+
+	END_BOOST_PY_NORET()
+
+	// Keep the capacity for the next tick.
+	if( m_Batch.empty() )
+	{
+		batch.clear();
+		batch.swap(m_Batch);
+	}
+}
+
+void CUserCmdManager::run_command( void* pPlayer, void* pCommand )
+{
+	bool bBatched = !m_BatchCallback.is_none();
+	if( !m_iOverrideCount && m_Callback.is_none() && !bBatched )
+		return;
+
+	edict_t* pEdict = EdictOfBaseEntity(pPlayer);
+	if( !pEdict || pEdict->IsFree() )
+		return;
+
+	int iIndex = IndexOfEdict(pEdict);
+	if( iIndex <= 0 || iIndex > gpGlobals->maxClients )
+		return;
+
+	CUserCmdView view(pCommand, m_Offsets);
+	if( m_Overrides[iIndex].active )
+		apply_overrides(m_Overrides[iIndex], view);
+
+	if( !m_Callback.is_none() )
+	{
+		object callback = m_Callback;
+
+		// Python owns its view, because the callback may keep a reference.
+		CUserCmdView* pView = new CUserCmdView(pCommand, m_Offsets);
+		manage_new_object::apply<CUserCmdView *>::type convert;
+		object python_view(handle<>(convert(pView)));
+
+		BEGIN_BOOST_PY()
+
+			callback(iIndex, python_view);
+
+		END_BOOST_PY_NORET()
+
+		// The CUserCmd doesn't outlive the command.
+		pView->invalidate();
+	}
+
+	if( !bBatched )
+		return;
+
+	// The batch holds the commands the way they are run.
+	UserCmdRecord_t record;
+	record.index = iIndex;
+	record.command_number = view.get_command_number();
+	record.tick_count = view.get_tick_count();
+
+	QAngle angles = view.get_view_angles();
+	record.view_angles[0] = angles.x;
+	record.view_angles[1] = angles.y;
+	record.view_angles[2] = angles.z;
+
+	record.forward_move = view.get_forward_move();
+	record.side_move = view.get_side_move();
+	record.up_move = view.get_up_move();
+	record.buttons = view.get_buttons();
+	record.impulse = view.get_impulse();
+	record.weapon_select = view.get_weapon_select();
+	record.random_seed = view.get_random_seed();
+	record.mouse_dx = (short) view.get_mouse_dx();
+	record.mouse_dy = (short) view.get_mouse_dy();
+	m_Batch.push_back(record);
+}
+
+void CUserCmdManager::apply_overrides( const PlayerOverrides_t& overrides, CUserCmdView& view )
+{
+	if( overrides.add_buttons || overrides.remove_buttons )
+		view.set_buttons((view.get_buttons() | overrides.add_buttons) & ~overrides.remove_buttons);
+
+	if( !overrides.fields )
+		return;
+
+	if( overrides.fields & (1 << USERCMD_FORWARD_MOVE) )
+		view.set_forward_move(overrides.values[USERCMD_FORWARD_MOVE]);
+
+	if( overrides.fields & (1 << USERCMD_SIDE_MOVE) )
+		view.set_side_move(overrides.values[USERCMD_SIDE_MOVE]);
+
+	if( overrides.fields & (1 << USERCMD_UP_MOVE) )
+		view.set_up_move(overrides.values[USERCMD_UP_MOVE]);
+
+	if( overrides.fields & (1 << USERCMD_IMPULSE) )
+		view.set_impulse((int) overrides.values[USERCMD_IMPULSE]);
+
+	if( overrides.fields & (1 << USERCMD_WEAPON_SELECT) )
+		view.set_weapon_select((int) overrides.values[USERCMD_WEAPON_SELECT]);
+
+	if( overrides.fields & (1 << USERCMD_WEAPON_SUBTYPE) )
+		view.set_weapon_subtype((int) overrides.values[USERCMD_WEAPON_SUBTYPE]);
+}
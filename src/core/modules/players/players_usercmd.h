@@ -0,0 +1,215 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _PLAYERS_USERCMD_H
+#define _PLAYERS_USERCMD_H
+
+// ----------------------------------------------------------------------------
+// Includes.
+// ----------------------------------------------------------------------------
+#include <vector>
+#include "edict.h"
+#include "const.h"
+#include "mathlib/vector.h"
+#include "utility/wrap_macros.h"
+
+// ----------------------------------------------------------------------------
+// CUserCmd members. Their offsets differ between games, so they are set from
+// the data files.
+// ----------------------------------------------------------------------------
+enum UserCmdField
+{
+	USERCMD_COMMAND_NUMBER = 0,
+	USERCMD_TICK_COUNT,
+	USERCMD_VIEW_ANGLES,
+	USERCMD_FORWARD_MOVE,
+	USERCMD_SIDE_MOVE,
+	USERCMD_UP_MOVE,
+	USERCMD_BUTTONS,
+	USERCMD_IMPULSE,
+	USERCMD_WEAPON_SELECT,
+	USERCMD_WEAPON_SUBTYPE,
+	USERCMD_RANDOM_SEED,
+	USERCMD_MOUSE_DX,
+	USERCMD_MOUSE_DY,
+
+	USERCMD_FIELD_COUNT
+};
+
+// ----------------------------------------------------------------------------
+// A command in the per tick batch buffer. Python unpacks the records with
+// USERCMD_RECORD_FORMAT, so both have to be changed together.
+// ----------------------------------------------------------------------------
+struct UserCmdRecord_t
+{
+	int		index;
+	int		command_number;
+	int		tick_count;
+	float	view_angles[3];
+	float	forward_move;
+	float	side_move;
+	float	up_move;
+	int		buttons;
+	int		impulse;
+	int		weapon_select;
+	int		random_seed;
+	short	mouse_dx;
+	short	mouse_dy;
+};
+
+#define USERCMD_RECORD_FORMAT "=3i6f4i2h"
+
+// ----------------------------------------------------------------------------
+// Typed view of a CUserCmd. It points into the game's memory, so the view
+// passed to Python is invalidated once the callback returned. Accessing it
+// after that raises an exception.
+// ----------------------------------------------------------------------------
+class CUserCmdView
+{
+public:
+	CUserCmdView( void* pCommand, const int* pOffsets );
+
+	int		get_command_number();
+	int		get_tick_count();
+
+	QAngle	get_view_angles();
+	void	set_view_angles( QAngle angles );
+
+	float	get_forward_move();
+	void	set_forward_move( float value );
+	float	get_side_move();
+	void	set_side_move( float value );
+	float	get_up_move();
+	void	set_up_move( float value );
+
+	int		get_buttons();
+	void	set_buttons( int value );
+	int		get_impulse();
+	void	set_impulse( int value );
+	int		get_weapon_select();
+	void	set_weapon_select( int value );
+	int		get_weapon_subtype();
+	void	set_weapon_subtype( int value );
+
+	int		get_random_seed();
+	int		get_mouse_dx();
+	int		get_mouse_dy();
+
+	// Address of the CUserCmd, for members that aren't wrapped here.
+	unsigned long	get_pointer();
+
+	// Detaches the view from the CUserCmd.
+	void	invalidate();
+
+private:
+	template<class T>
+	T*		get_field( UserCmdField field ) { return (T *) ((char *) get_command() + m_pOffsets[field]); }
+	void*	get_command();
+
+private:
+	void*		m_pCommand;
+	const int*	m_pOffsets;
+};
+
+// ----------------------------------------------------------------------------
+// Native usercmd processing. CBasePlayer::PlayerRunCommand is detoured the
+// first time it is needed. Overrides are applied to every command in C++. A
+// single callback can inspect and change each command through a
+// CUserCmdView, and a single batch callback receives all commands of a tick
+// as one buffer of UserCmdRecord_t. The PlayerRunCommand signature is only
+// known for Linux, so none of this is available on Windows servers.
+// ----------------------------------------------------------------------------
+class CUserCmdManager
+{
+public:
+	CUserCmdManager();
+
+	// Sets the address of PlayerRunCommand.
+	void	set_run_command_function( object pointer );
+
+	// Sets the offset of a CUserCmd member.
+	void	set_field_offset( UserCmdField field, int offset );
+
+	// Calls callback(index, view) for every command. None removes it.
+	void	set_callback( object callback );
+
+	// Calls callback(buffer) once per tick with the commands of the last tick.
+	// None removes it.
+	void	set_batch_callback( object callback );
+
+	// Overrides a move, impulse or weapon member of all commands of a player.
+	void	set_override( int player_index, UserCmdField field, float value );
+	void	remove_override( int player_index, UserCmdField field );
+
+	// Sets the buttons that are added to or removed from all commands of a
+	// player.
+	void	set_buttons( int player_index, int add_buttons, int remove_buttons );
+
+	// Drops all overrides of a player.
+	void	clear_player( int player_index );
+
+	// Drops the pending batch.
+	void	clear_batch();
+
+	// Drops the callbacks, overrides and the pending batch.
+	void	clear();
+
+	// Called once per frame to deliver the batch.
+	void	process();
+
+	// Called by the PlayerRunCommand hook.
+	void	run_command( void* pPlayer, void* pCommand );
+
+private:
+	struct PlayerOverrides_t
+	{
+		bool			active;
+		unsigned int	fields;
+		float			values[USERCMD_FIELD_COUNT];
+		int				add_buttons;
+		int				remove_buttons;
+	};
+
+	bool	install_hook();
+	bool	is_valid_field( UserCmdField field );
+	void	update_overrides( int player_index );
+	void	apply_overrides( const PlayerOverrides_t& overrides, CUserCmdView& view );
+
+private:
+	void*							m_pRunCommand;
+	bool							m_bHooked;
+	int								m_Offsets[USERCMD_FIELD_COUNT];
+	object							m_Callback;
+	object							m_BatchCallback;
+	PlayerOverrides_t				m_Overrides[ABSOLUTE_PLAYER_LIMIT + 1];
+
+	// Number of players that have overrides.
+	int								m_iOverrideCount;
+	std::vector<UserCmdRecord_t>	m_Batch;
+};
+
+CUserCmdManager* get_usercmd_manager();
+
+#endif // _PLAYERS_USERCMD_H
@@ -0,0 +1,313 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+// ----------------------------------------------------------------------------
+// Includes
+// ----------------------------------------------------------------------------
+#include <algorithm>
+#include "players_userids.h"
+#include "inetchannelinfo.h"
+#include "utility/sp_util.h"
+
+// ----------------------------------------------------------------------------
+// Global accessor.
+// ----------------------------------------------------------------------------
+CUserIDTable g_UserIDTable;
+
+// ----------------------------------------------------------------------------
+// Exposed functions.
+// ----------------------------------------------------------------------------
+object index_of_userid( int userid )
+{
+	int index = g_UserIDTable.index_of_userid(userid);
+	return index ? object(index) : object();
+}
+
+object index_of_networkid( const char* networkid )
+{
+	int index = g_UserIDTable.index_of_networkid(networkid);
+	return index ? object(index) : object();
+}
+
+object index_of_uniqueid( const char* uniqueid )
+{
+	int index = g_UserIDTable.index_of_uniqueid(uniqueid);
+	return index ? object(index) : object();
+}
+
+object userid_of_index( int index )
+{
+	int userid = g_UserIDTable.userid_of_index(index);
+	return userid == -1 ? object() : object(userid);
+}
+
+object networkid_of_index( int index )
+{
+	const char* networkid = g_UserIDTable.networkid_of_index(index);
+	return networkid ? object(networkid) : object();
+}
+
+object uniqueid_of_index( int index )
+{
+	const char* uniqueid = g_UserIDTable.uniqueid_of_index(index);
+	return uniqueid ? object(uniqueid) : object();
+}
+
+// ----------------------------------------------------------------------------
+// Returns the edict instance given a userid. Declared in sp_util.h.
+// ----------------------------------------------------------------------------
+edict_t* EdictOfUserid( int userid )
+{
+	int iIndex = g_UserIDTable.index_of_userid(userid);
+	if( !iIndex )
+		return NULL;
+
+	edict_t* pEdict = PEntityOfEntIndex(iIndex);
+	if( !pEdict || pEdict->IsFree() )
+		return NULL;
+
+	return pEdict;
+}
+
+// ----------------------------------------------------------------------------
+// Networkids and uniqueids aren't unique, e.g. all bots share one. Every key
+// keeps its slots sorted, so lookups return the lowest index like a loop
+// over all players would.
+// ----------------------------------------------------------------------------
+template<class T>
+static void AddSlotKey( boost::unordered_map<T, std::vector<int> >& map, const T& key, int index )
+{
+	std::vector<int>& slots = map[key];
+	slots.insert(std::lower_bound(slots.begin(), slots.end(), index), index);
+}
+
+template<class T>
+static void EraseSlotKey( boost::unordered_map<T, std::vector<int> >& map, const T& key, int index )
+{
+	typename boost::unordered_map<T, std::vector<int> >::iterator it = map.find(key);
+	if( it == map.end() )
+		return;
+
+	std::vector<int>& slots = it->second;
+	slots.erase(std::remove(slots.begin(), slots.end(), index), slots.end());
+	if( slots.empty() )
+		map.erase(it);
+}
+
+static void EraseSlot( std::vector<int>& slots, int index )
+{
+	slots.erase(std::remove(slots.begin(), slots.end(), index), slots.end());
+}
+
+// ----------------------------------------------------------------------------
+// CUserIDTable code.
+// ----------------------------------------------------------------------------
+CUserIDTable::CUserIDTable()
+{
+	for( int i = 0; i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+	{
+		m_Clients[i].userid = -1;
+	}
+}
+
+void CUserIDTable::add_player( edict_t* pEdict )
+{
+	if( !pEdict || pEdict->IsFree() )
+		return;
+
+	int index = IndexOfEdict(pEdict);
+	if( index < 1 || index > ABSOLUTE_PLAYER_LIMIT )
+		return;
+
+	remove_ids(index);
+
+	int userid = engine->GetPlayerUserId(pEdict);
+	if( userid == -1 )
+		return;
+
+	m_Clients[index].userid = userid;
+	m_UserIDs[userid] = index;
+	update_ids(index, pEdict);
+
+	// Bots are never validated.
+	IPlayerInfo* pPlayerInfo = playerinfomanager->GetPlayerInfo(pEdict);
+	if( !pPlayerInfo || !pPlayerInfo->IsFakeClient() )
+		m_Pending.push_back(index);
+}
+
+void CUserIDTable::remove_player( int index )
+{
+	if( index < 1 || index > ABSOLUTE_PLAYER_LIMIT )
+		return;
+
+	remove_ids(index);
+}
+
+void CUserIDTable::update_networkid( const char* networkid )
+{
+	for( unsigned int i = 0; i < m_Pending.size(); i++ )
+	{
+		int index = m_Pending[i];
+		edict_t* pEdict = PEntityOfEntIndex(index);
+		if( !pEdict || pEdict->IsFree() )
+			continue;
+
+		const char* szNetworkID = engine->GetPlayerNetworkIDString(pEdict);
+		if( !szNetworkID || strcmp(szNetworkID, networkid) != 0 )
+			continue;
+
+		m_Pending.erase(m_Pending.begin() + i);
+		if( m_Clients[index].networkid != szNetworkID )
+			update_ids(index, pEdict);
+
+		return;
+	}
+}
+
+void CUserIDTable::rebuild()
+{
+	clear();
+	for( int i = 1; i <= gpGlobals->maxClients && i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+	{
+		edict_t* pEdict = PEntityOfEntIndex(i);
+		if( !pEdict || pEdict->IsFree() || !pEdict->GetUnknown() )
+			continue;
+
+		add_player(pEdict);
+	}
+}
+
+void CUserIDTable::clear()
+{
+	for( int i = 0; i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+	{
+		m_Clients[i].userid = -1;
+		m_Clients[i].networkid.clear();
+		m_Clients[i].uniqueid.clear();
+	}
+
+	m_UserIDs.clear();
+	m_NetworkIDs.clear();
+	m_UniqueIDs.clear();
+	m_Pending.clear();
+}
+
+int CUserIDTable::index_of_userid( int userid )
+{
+	boost::unordered_map<int, int>::iterator it = m_UserIDs.find(userid);
+	return it == m_UserIDs.end() ? 0 : it->second;
+}
+
+int CUserIDTable::index_of_networkid( const char* networkid )
+{
+	SlotMap::iterator it = m_NetworkIDs.find(networkid);
+	return it == m_NetworkIDs.end() ? 0 : it->second.front();
+}
+
+int CUserIDTable::index_of_uniqueid( const char* uniqueid )
+{
+	SlotMap::iterator it = m_UniqueIDs.find(uniqueid);
+	return it == m_UniqueIDs.end() ? 0 : it->second.front();
+}
+
+int CUserIDTable::userid_of_index( int index )
+{
+	if( index < 1 || index > ABSOLUTE_PLAYER_LIMIT )
+		return -1;
+
+	return m_Clients[index].userid;
+}
+
+const char* CUserIDTable::networkid_of_index( int index )
+{
+	if( index < 1 || index > ABSOLUTE_PLAYER_LIMIT || m_Clients[index].userid == -1 )
+		return NULL;
+
+	return m_Clients[index].networkid.c_str();
+}
+
+const char* CUserIDTable::uniqueid_of_index( int index )
+{
+	if( index < 1 || index > ABSOLUTE_PLAYER_LIMIT || m_Clients[index].userid == -1 )
+		return NULL;
+
+	return m_Clients[index].uniqueid.c_str();
+}
+
+void CUserIDTable::update_ids( int index, edict_t* pEdict )
+{
+	Client_t& client = m_Clients[index];
+	EraseSlotKey(m_NetworkIDs, client.networkid, index);
+	EraseSlotKey(m_UniqueIDs, client.uniqueid, index);
+
+	const char* szNetworkID = engine->GetPlayerNetworkIDString(pEdict);
+	client.networkid = szNetworkID ? szNetworkID : "";
+
+	// Same rules as uniqueid_from_playerinfo on the Python side.
+	IPlayerInfo* pPlayerInfo = playerinfomanager->GetPlayerInfo(pEdict);
+	if( pPlayerInfo && pPlayerInfo->IsFakeClient() )
+	{
+		client.uniqueid = "BOT_";
+		client.uniqueid += pPlayerInfo->GetName();
+	}
+	else if( client.networkid.find("LAN") != std::string::npos )
+	{
+		INetChannelInfo* pNetInfo = engine->GetPlayerNetInfo(index);
+		std::string address = pNetInfo ? pNetInfo->GetAddress() : "";
+		address = address.substr(0, address.find(':'));
+		std::replace(address.begin(), address.end(), '.', '_');
+		client.uniqueid = "LAN_" + address;
+	}
+	else
+	{
+		client.uniqueid = client.networkid;
+	}
+
+	if( !client.networkid.empty() )
+		AddSlotKey(m_NetworkIDs, client.networkid, index);
+
+	if( !client.uniqueid.empty() )
+		AddSlotKey(m_UniqueIDs, client.uniqueid, index);
+}
+
+void CUserIDTable::remove_ids( int index )
+{
+	Client_t& client = m_Clients[index];
+	if( client.userid == -1 )
+		return;
+
+	boost::unordered_map<int, int>::iterator it = m_UserIDs.find(client.userid);
+	if( it != m_UserIDs.end() && it->second == index )
+		m_UserIDs.erase(it);
+
+	EraseSlotKey(m_NetworkIDs, client.networkid, index);
+	EraseSlotKey(m_UniqueIDs, client.uniqueid, index);
+	EraseSlot(m_Pending, index);
+
+	client.userid = -1;
+	client.networkid.clear();
+	client.uniqueid.clear();
+}
@@ -0,0 +1,110 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _PLAYERS_USERIDS_H
+#define _PLAYERS_USERIDS_H
+
+// ----------------------------------------------------------------------------
+// Includes.
+// ----------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include "edict.h"
+#include "const.h"
+#include "boost/unordered_map.hpp"
+#include "utility/wrap_macros.h"
+
+// ----------------------------------------------------------------------------
+// Native userid, index, networkid and uniqueid tables. The tables are
+// updated when clients are put in the server, validated or disconnected, so
+// every conversion is a single lookup instead of a loop over all slots.
+// ----------------------------------------------------------------------------
+class CUserIDTable
+{
+public:
+	CUserIDTable();
+
+	// Adds the client of the edict. Called when it's put in the server.
+	void		add_player( edict_t* pEdict );
+
+	// Removes the client of the slot. Called when it disconnects.
+	void		remove_player( int index );
+
+	// Reads the networkid of the client that got validated. Only clients
+	// that were put in the server before their validation are checked.
+	void		update_networkid( const char* networkid );
+
+	// Adds all clients that are already on the server.
+	void		rebuild();
+	void		clear();
+
+	// The lookups return 0, -1 or NULL if there's no such client. Shared
+	// networkids and uniqueids (e.g. of bots) return the lowest index.
+	int			index_of_userid( int userid );
+	int			index_of_networkid( const char* networkid );
+	int			index_of_uniqueid( const char* uniqueid );
+	int			userid_of_index( int index );
+	const char*	networkid_of_index( int index );
+	const char*	uniqueid_of_index( int index );
+
+private:
+	struct Client_t
+	{
+		int			userid;
+		std::string	networkid;
+		std::string	uniqueid;
+	};
+
+	typedef boost::unordered_map<std::string, std::vector<int> > SlotMap;
+
+	void		update_ids( int index, edict_t* pEdict );
+	void		remove_ids( int index );
+
+private:
+	Client_t								m_Clients[ABSOLUTE_PLAYER_LIMIT + 1];
+	boost::unordered_map<int, int>			m_UserIDs;
+	SlotMap									m_NetworkIDs;
+	SlotMap									m_UniqueIDs;
+
+	// Slots of clients that weren't validated yet.
+	std::vector<int>						m_Pending;
+};
+
+// ----------------------------------------------------------------------------
+// Global accessor.
+// ----------------------------------------------------------------------------
+extern CUserIDTable g_UserIDTable;
+
+// ----------------------------------------------------------------------------
+// Exposed functions. They return None if there's no such client.
+// ----------------------------------------------------------------------------
+object index_of_userid( int userid );
+object index_of_networkid( const char* networkid );
+object index_of_uniqueid( const char* uniqueid );
+object userid_of_index( int index );
+object networkid_of_index( int index );
+object uniqueid_of_index( int index );
+
+#endif // _PLAYERS_USERIDS_H
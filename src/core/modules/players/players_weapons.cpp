@@ -0,0 +1,327 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+// ----------------------------------------------------------------------------
+// Includes
+// ----------------------------------------------------------------------------
+#include "players_weapons.h"
+#include "dt_send.h"
+#include "modules/entities/entities_props.h"
+#include "utility/sp_util.h"
+
+// ----------------------------------------------------------------------------
+// External variables.
+// ----------------------------------------------------------------------------
+extern CGlobalVars* gpGlobals;
+
+// ----------------------------------------------------------------------------
+// Static singletons.
+// ----------------------------------------------------------------------------
+static CWeaponInventory s_WeaponInventory;
+
+// ----------------------------------------------------------------------------
+// WeaponInventory accessor.
+// ----------------------------------------------------------------------------
+CWeaponInventory* get_weapon_inventory()
+{
+	return &s_WeaponInventory;
+}
+
+// ----------------------------------------------------------------------------
+// Stores the offsets of all elements of an array prop. Arrays created with
+// SendPropArray3 are data tables with one prop per element.
+// ----------------------------------------------------------------------------
+static void GetArrayOffsets( edict_t* pEdict, const char* prop_name, std::vector<int>& offsets )
+{
+	int iOffset = 0;
+	SendProp* pProp = UTIL_GetSendProp(pEdict, prop_name, iOffset);
+	if( !pProp )
+		return;
+
+	switch( pProp->GetType() )
+	{
+		case DPT_DataTable:
+		{
+			SendTable* pTable = pProp->GetDataTable();
+			for( int i = 0; i < pTable->GetNumProps(); i++ )
+			{
+				offsets.push_back(iOffset + pTable->GetProp(i)->GetOffset());
+			}
+			break;
+		}
+
+		case DPT_Array:
+		{
+			for( int i = 0; i < pProp->GetNumElements(); i++ )
+			{
+				offsets.push_back(iOffset + i * pProp->GetElementStride());
+			}
+			break;
+		}
+
+		case DPT_Int:
+			offsets.push_back(iOffset);
+			break;
+	}
+}
+
+// ----------------------------------------------------------------------------
+// Returns the offset of an integer prop or -1.
+// ----------------------------------------------------------------------------
+static int GetIntOffset( edict_t* pEdict, const char* prop_name )
+{
+	int iOffset = 0;
+	SendProp* pProp = UTIL_GetSendProp(pEdict, prop_name, iOffset);
+	if( !pProp || pProp->GetType() != DPT_Int )
+		return -1;
+
+	return iOffset;
+}
+
+// ----------------------------------------------------------------------------
+// Returns the edict of a player or raises an exception.
+// ----------------------------------------------------------------------------
+static edict_t* GetPlayerEdict( int player_index )
+{
+	if( player_index <= 0 || player_index > gpGlobals->maxClients )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid player index.")
+
+	edict_t* pEdict = PEntityOfEntIndex(player_index);
+	if( !pEdict || pEdict->IsFree() || !pEdict->GetUnknown() )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Player is not valid.")
+
+	return pEdict;
+}
+
+// ----------------------------------------------------------------------------
+// Returns the edict of a weapon or raises an exception.
+// ----------------------------------------------------------------------------
+static edict_t* GetWeaponEdict( int weapon_index )
+{
+	if( weapon_index <= 0 || weapon_index >= MAX_EDICTS )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid entity index.")
+
+	edict_t* pEdict = PEntityOfEntIndex(weapon_index);
+	if( !pEdict || pEdict->IsFree() || !pEdict->GetUnknown() )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Weapon is not valid.")
+
+	return pEdict;
+}
+
+// ----------------------------------------------------------------------------
+// CWeaponInventory code.
+// ----------------------------------------------------------------------------
+CWeaponInventory::CWeaponInventory()
+{
+	clear();
+}
+
+list CWeaponInventory::get_weapons( int player_index )
+{
+	const PlayerWeapons_t& player = update_player(player_index);
+
+	list weapons;
+	for( unsigned int i = 0; i < player.indexes.size(); i++ )
+	{
+		weapons.append(player.indexes[i]);
+	}
+
+	return weapons;
+}
+
+object CWeaponInventory::find_weapon( int player_index, object classnames )
+{
+	std::vector<std::string> names;
+	extract<const char *> classname(classnames);
+	if( classname.check() )
+	{
+		names.push_back(classname());
+	}
+	else
+	{
+		int iLength = len(classnames);
+		for( int i = 0; i < iLength; i++ )
+		{
+			names.push_back(extract<const char *>(classnames[i])());
+		}
+	}
+
+	const PlayerWeapons_t& player = update_player(player_index);
+	for( unsigned int i = 0; i < player.indexes.size(); i++ )
+	{
+		edict_t* pWeapon = PEntityOfEntIndex(player.indexes[i]);
+		if( !pWeapon || pWeapon->IsFree() )
+			continue;
+
+		const char* szClassName = pWeapon->GetClassName();
+		for( unsigned int j = 0; j < names.size(); j++ )
+		{
+			if( V_stricmp(names[j].c_str(), szClassName) == 0 )
+				return object(player.indexes[i]);
+		}
+	}
+
+	return object();
+}
+
+int CWeaponInventory::get_clip( int weapon_index )
+{
+	edict_t* pEdict = GetWeaponEdict(weapon_index);
+	const ClassOffsets_t& offsets = get_offsets(pEdict);
+	if( offsets.iClip < 0 )
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Entity has no clip.")
+
+	return *(int *) (get_base(pEdict) + offsets.iClip);
+}
+
+void CWeaponInventory::set_clip( int weapon_index, int value )
+{
+	edict_t* pEdict = GetWeaponEdict(weapon_index);
+	const ClassOffsets_t& offsets = get_offsets(pEdict);
+	if( offsets.iClip < 0 )
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Entity has no clip.")
+
+	*(int *) (get_base(pEdict) + offsets.iClip) = value;
+	pEdict->StateChanged(offsets.iClip);
+}
+
+int CWeaponInventory::get_ammo_type( int weapon_index )
+{
+	edict_t* pEdict = GetWeaponEdict(weapon_index);
+	const ClassOffsets_t& offsets = get_offsets(pEdict);
+	if( offsets.iAmmoType < 0 )
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Entity has no ammo type.")
+
+	return *(int *) (get_base(pEdict) + offsets.iAmmoType);
+}
+
+int CWeaponInventory::get_ammo( int player_index, int weapon_index )
+{
+	int* pAmmo = get_ammo_slot(player_index, weapon_index);
+	return pAmmo ? *pAmmo : 0;
+}
+
+void CWeaponInventory::set_ammo( int player_index, int weapon_index, int value )
+{
+	int* pAmmo = get_ammo_slot(player_index, weapon_index);
+	if( !pAmmo )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Weapon doesn't use reserve ammo.")
+
+	*pAmmo = value;
+
+	edict_t* pEdict = PEntityOfEntIndex(player_index);
+	pEdict->StateChanged((char *) pAmmo - get_base(pEdict));
+}
+
+void CWeaponInventory::invalidate( int player_index )
+{
+	if( player_index < 0 || player_index > ABSOLUTE_PLAYER_LIMIT )
+		return;
+
+	m_Players[player_index].iSerialNumber = -1;
+	m_Players[player_index].handles.clear();
+	m_Players[player_index].indexes.clear();
+}
+
+void CWeaponInventory::clear()
+{
+	for( int i = 0; i <= ABSOLUTE_PLAYER_LIMIT; i++ )
+	{
+		invalidate(i);
+	}
+}
+
+const CWeaponInventory::ClassOffsets_t& CWeaponInventory::get_offsets( edict_t* pEdict )
+{
+	ServerClass* pServerClass = pEdict->GetNetworkable()->GetServerClass();
+
+	boost::unordered_map<ServerClass*, ClassOffsets_t>::iterator it = m_Offsets.find(pServerClass);
+	if( it != m_Offsets.end() )
+		return it->second;
+
+	// Server classes live as long as the game, so they can be used as keys.
+	ClassOffsets_t& offsets = m_Offsets[pServerClass];
+	GetArrayOffsets(pEdict, "m_hMyWeapons", offsets.weapons);
+	GetArrayOffsets(pEdict, "m_iAmmo", offsets.ammo);
+	offsets.iClip = GetIntOffset(pEdict, "m_iClip1");
+	offsets.iAmmoType = GetIntOffset(pEdict, "m_iPrimaryAmmoType");
+	return offsets;
+}
+
+const CWeaponInventory::PlayerWeapons_t& CWeaponInventory::update_player( int player_index )
+{
+	edict_t* pEdict = GetPlayerEdict(player_index);
+	const ClassOffsets_t& offsets = get_offsets(pEdict);
+	char* pBase = get_base(pEdict);
+
+	// Only resolve the handles again if the array changed. The cached
+	// handles are compared in place, so an unchanged array costs no copy.
+	PlayerWeapons_t& player = m_Players[player_index];
+	bool bChanged = player.iSerialNumber != pEdict->m_NetworkSerialNumber ||
+		player.handles.size() != offsets.weapons.size();
+
+	for( unsigned int i = 0; !bChanged && i < offsets.weapons.size(); i++ )
+	{
+		bChanged = player.handles[i] != *(int *) (pBase + offsets.weapons[i]);
+	}
+
+	if( !bChanged )
+		return player;
+
+	player.iSerialNumber = pEdict->m_NetworkSerialNumber;
+	player.handles.resize(offsets.weapons.size());
+	for( unsigned int i = 0; i < offsets.weapons.size(); i++ )
+	{
+		player.handles[i] = *(int *) (pBase + offsets.weapons[i]);
+	}
+
+	player.indexes.clear();
+	for( unsigned int i = 0; i < player.handles.size(); i++ )
+	{
+		int index = ResolveIntHandle(player.handles[i]);
+		if( index > 0 )
+			player.indexes.push_back(index);
+	}
+
+	return player;
+}
+
+char* CWeaponInventory::get_base( edict_t* pEdict )
+{
+	return (char *) pEdict->GetUnknown()->GetBaseEntity();
+}
+
+int* CWeaponInventory::get_ammo_slot( int player_index, int weapon_index )
+{
+	edict_t* pPlayer = GetPlayerEdict(player_index);
+	int iAmmoType = get_ammo_type(weapon_index);
+
+	const ClassOffsets_t& offsets = get_offsets(pPlayer);
+	if( iAmmoType < 0 || iAmmoType >= (int) offsets.ammo.size() )
+		return NULL;
+
+	return (int *) (get_base(pPlayer) + offsets.ammo[iAmmoType]);
+}
@@ -0,0 +1,97 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _PLAYERS_WEAPONS_H
+#define _PLAYERS_WEAPONS_H
+
+// ----------------------------------------------------------------------------
+// Includes.
+// ----------------------------------------------------------------------------
+#include <vector>
+#include "edict.h"
+#include "const.h"
+#include "server_class.h"
+#include "boost/unordered_map.hpp"
+#include "utility/wrap_macros.h"
+
+// ----------------------------------------------------------------------------
+// Native owner to weapons index. The weapons of a player are resolved from
+// the m_hMyWeapons handle array and only resolved again when the array
+// changed. Clip and ammo props are looked up once per server class, so ammo
+// queries cost a single call from Python.
+// ----------------------------------------------------------------------------
+class CWeaponInventory
+{
+public:
+	CWeaponInventory();
+
+	// Returns the indexes of all weapons of the player.
+	list	get_weapons( int player_index );
+
+	// Returns the index of the player's first weapon of the given classname(s)
+	// or None. classnames can be a string or a sequence of strings.
+	object	find_weapon( int player_index, object classnames );
+
+	int		get_clip( int weapon_index );
+	void	set_clip( int weapon_index, int value );
+	int		get_ammo_type( int weapon_index );
+
+	// Reserve ammo of the player for the weapon's primary ammo type.
+	int		get_ammo( int player_index, int weapon_index );
+	void	set_ammo( int player_index, int weapon_index, int value );
+
+	// Drops the cached weapons of a player or of all players.
+	void	invalidate( int player_index );
+	void	clear();
+
+private:
+	struct ClassOffsets_t
+	{
+		std::vector<int>	weapons;
+		std::vector<int>	ammo;
+		int					iClip;
+		int					iAmmoType;
+	};
+
+	struct PlayerWeapons_t
+	{
+		int					iSerialNumber;
+		std::vector<int>	handles;
+		std::vector<int>	indexes;
+	};
+
+	const ClassOffsets_t&	get_offsets( edict_t* pEdict );
+	const PlayerWeapons_t&	update_player( int player_index );
+	char*					get_base( edict_t* pEdict );
+	int*					get_ammo_slot( int player_index, int weapon_index );
+
+private:
+	boost::unordered_map<ServerClass*, ClassOffsets_t>	m_Offsets;
+	PlayerWeapons_t										m_Players[ABSOLUTE_PLAYER_LIMIT + 1];
+};
+
+CWeaponInventory* get_weapon_inventory();
+
+#endif // _PLAYERS_WEAPONS_H
@@ -30,6 +30,7 @@
 #include "players_wrap.h"
 #include "mathlib/vector.h"
 #include "modules/entities/entities_wrap.h"
+#include "modules/entities/entities_cache.h"
 #include "utility/sp_util.h"
 
 // ----------------------------------------------------------------------------
@@ -40,148 +41,163 @@ extern IPlayerInfoManager* playerinfomanager;
 // ----------------------------------------------------------------------------
 // CPlayerInfo methods.
 // ----------------------------------------------------------------------------
+CPlayerInfo::CPlayerInfo()
+{
+	m_iplayerinfo_ptr = NULL;
+	m_edict_ptr = NULL;
+}
+
 CPlayerInfo::CPlayerInfo( IPlayerInfo* iplayerinfo )
 {
 	m_iplayerinfo_ptr = iplayerinfo;
-	edict_t* edict = EdictOfPlayer(m_iplayerinfo_ptr);
-	CEdict* m_edict = new CEdict(edict);
-	m_edict_ptr = m_edict;
+	m_edict_ptr = EdictOfPlayer(m_iplayerinfo_ptr);
 }
 
 CPlayerInfo::CPlayerInfo( CEdict* edict_ptr )
 {
-	m_edict_ptr = edict_ptr;
-	int index = m_edict_ptr->get_index();
-	edict_t* edict = PEntityOfEntIndex(index);
-	m_iplayerinfo_ptr = playerinfomanager->GetPlayerInfo(edict);
+	m_edict_ptr = PEntityOfEntIndex(edict_ptr->get_index());
+	m_iplayerinfo_ptr = playerinfomanager->GetPlayerInfo(m_edict_ptr);
 }
 
 CPlayerInfo::CPlayerInfo( int userid )
 {
 	m_iplayerinfo_ptr = PlayerOfUserid(userid);
-	edict_t* edict = EdictOfPlayer(m_iplayerinfo_ptr);
-	CEdict* m_edict = new CEdict(edict);
-	m_edict_ptr = m_edict;
+	m_edict_ptr = EdictOfPlayer(m_iplayerinfo_ptr);
+}
+
+void CPlayerInfo::set_player( IPlayerInfo* playerinfo, edict_t* edict )
+{
+	m_iplayerinfo_ptr = playerinfo;
+	m_edict_ptr = edict;
+}
+
+IPlayerInfo* CPlayerInfo::get_info() const
+{
+	if( !m_iplayerinfo_ptr )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Player is not on the server.")
+
+	return m_iplayerinfo_ptr;
 }
 
 const char* CPlayerInfo::get_name() const
 {
-	return m_iplayerinfo_ptr->GetName();
+	return get_info()->GetName();
 }
 
 int CPlayerInfo::get_userid() const
 {
-	return m_iplayerinfo_ptr->GetUserID();
+	return get_info()->GetUserID();
 }
 
 const char* CPlayerInfo::get_networkid_string() const
 {
-	return m_iplayerinfo_ptr->GetNetworkIDString();
+	return get_info()->GetNetworkIDString();
 }
 
 int CPlayerInfo::get_team_index() const
 {
-	return m_iplayerinfo_ptr->GetTeamIndex();
+	return get_info()->GetTeamIndex();
 }
 
 void CPlayerInfo::change_team( int iTeamNum )
 {
-	m_iplayerinfo_ptr->ChangeTeam(iTeamNum);
+	get_info()->ChangeTeam(iTeamNum);
 }
 
 int CPlayerInfo::get_frag_count() const
 {
-	return m_iplayerinfo_ptr->GetFragCount();
+	return get_info()->GetFragCount();
 }
 
 int CPlayerInfo::get_death_count() const
 {
-	return m_iplayerinfo_ptr->GetDeathCount();
+	return get_info()->GetDeathCount();
 }
 
 bool CPlayerInfo::is_connected() const
 {
-	return m_iplayerinfo_ptr->IsConnected();
+	return get_info()->IsConnected();
 }
 
 int CPlayerInfo::get_armor_value() const
 {
-	return m_iplayerinfo_ptr->GetArmorValue();
+	return get_info()->GetArmorValue();
 }
 
 bool CPlayerInfo::is_hltv() const
 {
-	return m_iplayerinfo_ptr->IsHLTV();
+	return get_info()->IsHLTV();
 }
 
 bool CPlayerInfo::is_player() const
 {
-	return m_iplayerinfo_ptr->IsPlayer();
+	return get_info()->IsPlayer();
 }
 
 bool CPlayerInfo::is_fake_client() const
 {
-	return m_iplayerinfo_ptr->IsFakeClient();
+	return get_info()->IsFakeClient();
 }
 
 bool CPlayerInfo::is_dead() const
 {
-	return m_iplayerinfo_ptr->IsDead();
+	return get_info()->IsDead();
 }
 
 bool CPlayerInfo::is_in_a_vehicle() const
 {
-	return m_iplayerinfo_ptr->IsInAVehicle();
+	return get_info()->IsInAVehicle();
 }
 
 bool CPlayerInfo::is_observer() const
 {
-	return m_iplayerinfo_ptr->IsObserver();
+	return get_info()->IsObserver();
 }
 
 const CVector CPlayerInfo::get_abs_origin() const
 {
-	return CVector(m_iplayerinfo_ptr->GetAbsOrigin());
+	return CVector(get_info()->GetAbsOrigin());
 }
 
 const QAngle CPlayerInfo::get_abs_angles() const
 {
-	return m_iplayerinfo_ptr->GetAbsAngles();
+	return get_info()->GetAbsAngles();
 }
 
 const CVector CPlayerInfo::get_player_mins() const
 {
-	return CVector(m_iplayerinfo_ptr->GetPlayerMins());
+	return CVector(get_info()->GetPlayerMins());
 }
 
 const CVector CPlayerInfo::get_player_maxs() const
 {
-	return CVector(m_iplayerinfo_ptr->GetPlayerMaxs());
+	return CVector(get_info()->GetPlayerMaxs());
 }
 
 const char* CPlayerInfo::get_weapon_name() const
 {
-	return m_iplayerinfo_ptr->GetWeaponName();
+	return get_info()->GetWeaponName();
 }
 
 const char* CPlayerInfo::get_model_name() const
 {
-	return m_iplayerinfo_ptr->GetModelName();
+	return get_info()->GetModelName();
 }
 
 int CPlayerInfo::get_health() const
 {
-	return m_iplayerinfo_ptr->GetHealth();
+	return get_info()->GetHealth();
 }
 
 int CPlayerInfo::get_max_health() const
 {
-	return m_iplayerinfo_ptr->GetMaxHealth();
+	return get_info()->GetMaxHealth();
 }
 
-CEdict* CPlayerInfo::get_edict() const
+object CPlayerInfo::get_edict() const
 {
-	return m_edict_ptr;
+	get_info();
+	return g_EdictCache.get_edict(m_edict_ptr);
 }
 
 //-----------------------------------------------------------------------------
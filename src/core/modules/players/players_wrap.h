@@ -43,6 +43,9 @@ class CPlayerInfo
 {
 public:
 
+	// Empty instance for the per slot pool.
+	CPlayerInfo();
+
 	// Get CPlayerInfo instances by index.
 	CPlayerInfo( int userid );
 
@@ -75,10 +78,17 @@ public:
 	virtual const char* 		get_model_name() const;
 	virtual int 				get_health() const;
 	virtual int 				get_max_health() const;
-	virtual CEdict*			get_edict() const;
+	virtual object			get_edict() const;
+
+	// Points the instance to another player. NULL detaches it.
+	void						set_player( IPlayerInfo* playerinfo, edict_t* edict );
+
+private:
+	// Raises an exception if the player left.
+	IPlayerInfo*				get_info() const;
 
 private:
-	CEdict*			m_edict_ptr;
+	edict_t*		m_edict_ptr;
 	IPlayerInfo*	m_iplayerinfo_ptr;
 };
 
@@ -29,6 +29,14 @@
 // ----------------------------------------------------------------------------
 #include "players_generator_wrap.h"
 #include "players_wrap.h"
+#include "players_cache.h"
+#include "players_weapons.h"
+#include "players_usercmd.h"
+#include "players_userids.h"
+#include "players_snapshot.h"
+#include "players_filters.h"
+#include "players_netstats.h"
+#include "players_convars.h"
 #include "modules/entities/entities_wrap.h"
 #include "modules/export_main.h"
 
@@ -43,6 +51,14 @@ using namespace boost::python;
 void export_playerinfo();
 void export_netinfo();
 void export_player_generator();
+void export_playerinfo_cache();
+void export_weapon_inventory();
+void export_usercmd_manager();
+void export_userid_table();
+void export_player_snapshot();
+void export_player_filter_masks();
+void export_net_channel_sampler();
+void export_client_convar_cache();
 
 // ----------------------------------------------------------------------------
 // Entity module definition.
@@ -52,6 +68,14 @@ DECLARE_SP_MODULE(player_c)
 	export_playerinfo();
 	export_netinfo();
 	export_player_generator();
+	export_playerinfo_cache();
+	export_weapon_inventory();
+	export_usercmd_manager();
+	export_userid_table();
+	export_player_snapshot();
+	export_player_filter_masks();
+	export_net_channel_sampler();
+	export_client_convar_cache();
 }
 
 // ----------------------------------------------------------------------------
@@ -181,8 +205,7 @@ void export_playerinfo()
 
 		CLASS_METHOD(CPlayerInfo,
 			get_edict,
-			"Returns the player's CEdict instance.",
-			manage_new_object_policy()
+			"Returns the player's CEdict instance."
 		)
 
 	BOOST_END_CLASS()
@@ -210,3 +233,528 @@ void export_player_generator()
 	BOOST_GENERATOR_CLASS(CPlayerGenerator)
 	BOOST_END_CLASS()
 }
+
+// ----------------------------------------------------------------------------
+// Exports the CPlayerInfo cache.
+// ----------------------------------------------------------------------------
+void export_playerinfo_cache()
+{
+	BOOST_FUNCTION(get_cached_playerinfo,
+		"Returns the CPlayerInfo instance of the player at the given index or None. The instance raises once the player left.",
+		args("index")
+	);
+}
+
+// ----------------------------------------------------------------------------
+// Exports the userid tables.
+// ----------------------------------------------------------------------------
+void export_userid_table()
+{
+	BOOST_FUNCTION(index_of_userid,
+		"Returns the index of the userid or None.",
+		args("userid")
+	);
+
+	BOOST_FUNCTION(index_of_networkid,
+		"Returns the index of the networkid or None. Clients that share a networkid, like bots, return one of them.",
+		args("networkid")
+	);
+
+	BOOST_FUNCTION(index_of_uniqueid,
+		"Returns the index of the uniqueid or None.",
+		args("uniqueid")
+	);
+
+	BOOST_FUNCTION(userid_of_index,
+		"Returns the userid of the index or None.",
+		args("index")
+	);
+
+	BOOST_FUNCTION(networkid_of_index,
+		"Returns the networkid of the index or None.",
+		args("index")
+	);
+
+	BOOST_FUNCTION(uniqueid_of_index,
+		"Returns the uniqueid of the index or None.",
+		args("index")
+	);
+}
+
+// ----------------------------------------------------------------------------
+// Exports CWeaponInventory.
+// ----------------------------------------------------------------------------
+void export_weapon_inventory()
+{
+	BOOST_ABSTRACT_CLASS(CWeaponInventory)
+
+		CLASS_METHOD(CWeaponInventory,
+			get_weapons,
+			"Returns the indexes of all weapons of the player.",
+			args("player_index")
+		)
+
+		CLASS_METHOD(CWeaponInventory,
+			find_weapon,
+			"Returns the index of the player's first weapon of the given classname(s) or None.",
+			args("player_index", "classnames")
+		)
+
+		CLASS_METHOD(CWeaponInventory,
+			get_clip,
+			"Returns the weapon's clip.",
+			args("weapon_index")
+		)
+
+		CLASS_METHOD(CWeaponInventory,
+			set_clip,
+			"Sets the weapon's clip.",
+			args("weapon_index", "value")
+		)
+
+		CLASS_METHOD(CWeaponInventory,
+			get_ammo_type,
+			"Returns the weapon's primary ammo type.",
+			args("weapon_index")
+		)
+
+		CLASS_METHOD(CWeaponInventory,
+			get_ammo,
+			"Returns the player's reserve ammo for the weapon.",
+			args("player_index", "weapon_index")
+		)
+
+		CLASS_METHOD(CWeaponInventory,
+			set_ammo,
+			"Sets the player's reserve ammo for the weapon.",
+			args("player_index", "weapon_index", "value")
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_weapon_inventory,
+		"Returns the CWeaponInventory instance",
+		reference_existing_object_policy()
+	);
+}
+
+// ----------------------------------------------------------------------------
+// Exports CUserCmdManager.
+// ----------------------------------------------------------------------------
+void export_usercmd_manager()
+{
+	BOOST_ENUM( UserCmdField )
+		ENUM_VALUE( "USERCMD_COMMAND_NUMBER", USERCMD_COMMAND_NUMBER )
+		ENUM_VALUE( "USERCMD_TICK_COUNT", USERCMD_TICK_COUNT )
+		ENUM_VALUE( "USERCMD_VIEW_ANGLES", USERCMD_VIEW_ANGLES )
+		ENUM_VALUE( "USERCMD_FORWARD_MOVE", USERCMD_FORWARD_MOVE )
+		ENUM_VALUE( "USERCMD_SIDE_MOVE", USERCMD_SIDE_MOVE )
+		ENUM_VALUE( "USERCMD_UP_MOVE", USERCMD_UP_MOVE )
+		ENUM_VALUE( "USERCMD_BUTTONS", USERCMD_BUTTONS )
+		ENUM_VALUE( "USERCMD_IMPULSE", USERCMD_IMPULSE )
+		ENUM_VALUE( "USERCMD_WEAPON_SELECT", USERCMD_WEAPON_SELECT )
+		ENUM_VALUE( "USERCMD_WEAPON_SUBTYPE", USERCMD_WEAPON_SUBTYPE )
+		ENUM_VALUE( "USERCMD_RANDOM_SEED", USERCMD_RANDOM_SEED )
+		ENUM_VALUE( "USERCMD_MOUSE_DX", USERCMD_MOUSE_DX )
+		ENUM_VALUE( "USERCMD_MOUSE_DY", USERCMD_MOUSE_DY )
+	BOOST_END_CLASS()
+
+	// struct format of the records in the batch buffer.
+	scope().attr("USERCMD_RECORD_FORMAT") = USERCMD_RECORD_FORMAT;
+
+	BOOST_ABSTRACT_CLASS(CUserCmdView)
+
+		CLASS_PROPERTY_READ_ONLY(CUserCmdView,
+			"command_number",
+			get_command_number,
+			"Returns the number of the command."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CUserCmdView,
+			"tick_count",
+			get_tick_count,
+			"Returns the client tick of the command."
+		)
+
+		CLASS_PROPERTY_READWRITE(CUserCmdView,
+			"view_angles",
+			get_view_angles,
+			set_view_angles,
+			"Returns or sets the view angles QAngle."
+		)
+
+		CLASS_PROPERTY_READWRITE(CUserCmdView,
+			"forward_move",
+			get_forward_move,
+			set_forward_move,
+			"Returns or sets the forward move."
+		)
+
+		CLASS_PROPERTY_READWRITE(CUserCmdView,
+			"side_move",
+			get_side_move,
+			set_side_move,
+			"Returns or sets the side move."
+		)
+
+		CLASS_PROPERTY_READWRITE(CUserCmdView,
+			"up_move",
+			get_up_move,
+			set_up_move,
+			"Returns or sets the up move."
+		)
+
+		CLASS_PROPERTY_READWRITE(CUserCmdView,
+			"buttons",
+			get_buttons,
+			set_buttons,
+			"Returns or sets the button bits."
+		)
+
+		CLASS_PROPERTY_READWRITE(CUserCmdView,
+			"impulse",
+			get_impulse,
+			set_impulse,
+			"Returns or sets the impulse."
+		)
+
+		CLASS_PROPERTY_READWRITE(CUserCmdView,
+			"weapon_select",
+			get_weapon_select,
+			set_weapon_select,
+			"Returns or sets the entity index of the selected weapon."
+		)
+
+		CLASS_PROPERTY_READWRITE(CUserCmdView,
+			"weapon_subtype",
+			get_weapon_subtype,
+			set_weapon_subtype,
+			"Returns or sets the subtype of the selected weapon."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CUserCmdView,
+			"random_seed",
+			get_random_seed,
+			"Returns the random seed of the command."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CUserCmdView,
+			"mouse_dx",
+			get_mouse_dx,
+			"Returns the horizontal mouse delta."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CUserCmdView,
+			"mouse_dy",
+			get_mouse_dy,
+			"Returns the vertical mouse delta."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CUserCmdView,
+			"pointer",
+			get_pointer,
+			"Returns the address of the CUserCmd."
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_ABSTRACT_CLASS(CUserCmdManager)
+
+		CLASS_METHOD(CUserCmdManager,
+			set_run_command_function,
+			"Sets the address of PlayerRunCommand. Only Linux has a signature for it, so callbacks, batches and overrides are not available on Windows.",
+			args("pointer")
+		)
+
+		CLASS_METHOD(CUserCmdManager,
+			set_field_offset,
+			"Sets the offset of a CUserCmd member.",
+			args("field", "offset")
+		)
+
+		CLASS_METHOD(CUserCmdManager,
+			set_callback,
+			"Calls callback(index, view) for every command. The CUserCmdView raises a RuntimeError once the call returned. None removes the callback.",
+			args("callback")
+		)
+
+		CLASS_METHOD(CUserCmdManager,
+			set_batch_callback,
+			"Calls callback(buffer) once per tick with the commands of the last tick, packed with USERCMD_RECORD_FORMAT. None removes the callback.",
+			args("callback")
+		)
+
+		CLASS_METHOD(CUserCmdManager,
+			set_override,
+			"Overrides a move, impulse or weapon member of all commands of the player.",
+			args("player_index", "field", "value")
+		)
+
+		CLASS_METHOD(CUserCmdManager,
+			remove_override,
+			"Removes the override of a member.",
+			args("player_index", "field")
+		)
+
+		CLASS_METHOD(CUserCmdManager,
+			set_buttons,
+			"Sets the buttons that are added to or removed from all commands of the player.",
+			args("player_index", "add_buttons", "remove_buttons")
+		)
+
+		CLASS_METHOD(CUserCmdManager,
+			clear_player,
+			"Removes all overrides of the player.",
+			args("player_index")
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_usercmd_manager,
+		"Returns the CUserCmdManager instance",
+		reference_existing_object_policy()
+	);
+}
+
+// ----------------------------------------------------------------------------
+// Exports CPlayerSnapshot.
+// ----------------------------------------------------------------------------
+void export_player_snapshot()
+{
+	BOOST_ENUM( PlayerSnapshotField )
+		ENUM_VALUE( "SNAPSHOT_ORIGIN", SNAPSHOT_ORIGIN )
+		ENUM_VALUE( "SNAPSHOT_ANGLES", SNAPSHOT_ANGLES )
+		ENUM_VALUE( "SNAPSHOT_HEALTH", SNAPSHOT_HEALTH )
+		ENUM_VALUE( "SNAPSHOT_ARMOR", SNAPSHOT_ARMOR )
+		ENUM_VALUE( "SNAPSHOT_TEAM", SNAPSHOT_TEAM )
+		ENUM_VALUE( "SNAPSHOT_ALIVE", SNAPSHOT_ALIVE )
+		ENUM_VALUE( "SNAPSHOT_WEAPON", SNAPSHOT_WEAPON )
+		ENUM_VALUE( "SNAPSHOT_ALL", SNAPSHOT_ALL )
+	BOOST_END_CLASS()
+
+	BOOST_ABSTRACT_CLASS(CPlayerSnapshot)
+
+		CLASS_PROPERTY_READ_ONLY(CPlayerSnapshot,
+			"fields",
+			get_fields,
+			"Returns the fields filled by the last update."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CPlayerSnapshot,
+			"valid",
+			get_valid,
+			"Returns a memoryview with one byte per player index. 1 if the slot has a connected player."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CPlayerSnapshot,
+			"origins",
+			get_origins,
+			"Returns a memoryview with three floats per player index."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CPlayerSnapshot,
+			"angles",
+			get_angles,
+			"Returns a memoryview with three floats per player index."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CPlayerSnapshot,
+			"health",
+			get_health,
+			"Returns a memoryview with one int per player index."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CPlayerSnapshot,
+			"armor",
+			get_armor,
+			"Returns a memoryview with one int per player index."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CPlayerSnapshot,
+			"teams",
+			get_teams,
+			"Returns a memoryview with one int per player index."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CPlayerSnapshot,
+			"alive",
+			get_alive,
+			"Returns a memoryview with one byte per player index."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CPlayerSnapshot,
+			"weapons",
+			get_weapons,
+			"Returns a list with the weapon name or None of every player index."
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_player_snapshot,
+		"Fills the given PlayerSnapshotField columns for all player slots and returns the CPlayerSnapshot instance. The views are shared and overwritten by the next call.",
+		args("fields"),
+		reference_existing_object_policy()
+	);
+}
+
+// ----------------------------------------------------------------------------
+// Exports CPlayerFilterMasks.
+// ----------------------------------------------------------------------------
+void export_player_filter_masks()
+{
+	BOOST_ABSTRACT_CLASS(CPlayerFilterMasks)
+
+		CLASS_METHOD(CPlayerFilterMasks,
+			register_team,
+			"Adds a filter that matches the players of the team.",
+			args("name", "team")
+		)
+
+		CLASS_METHOD(CPlayerFilterMasks,
+			has_filter,
+			"Returns whether the filter is resolved natively.",
+			args("name")
+		)
+
+		CLASS_METHOD(CPlayerFilterMasks,
+			get_indexes,
+			"Returns a list with the indexes of the players that pass all is_filters and none of the not_filters, or None if one of the filters isn't native.",
+			args("is_filters", "not_filters")
+		)
+
+		CLASS_METHOD(CPlayerFilterMasks,
+			invalidate,
+			"Makes the next query rebuild the connection masks."
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_player_filter_masks,
+		"Returns the CPlayerFilterMasks instance",
+		reference_existing_object_policy()
+	);
+}
+
+// ----------------------------------------------------------------------------
+// Exports CNetChannelSampler.
+// ----------------------------------------------------------------------------
+DECLARE_CLASS_METHOD_OVERLOAD(CNetChannelSampler, get_stats, 2, 3);
+DECLARE_CLASS_METHOD_OVERLOAD(CNetChannelSampler, add_threshold, 3, 5);
+
+void export_net_channel_sampler()
+{
+	BOOST_ENUM( NetStatMetric )
+		ENUM_VALUE( "NETSTAT_LATENCY", NETSTAT_LATENCY )
+		ENUM_VALUE( "NETSTAT_LOSS", NETSTAT_LOSS )
+		ENUM_VALUE( "NETSTAT_CHOKE", NETSTAT_CHOKE )
+		ENUM_VALUE( "NETSTAT_IN_RATE", NETSTAT_IN_RATE )
+		ENUM_VALUE( "NETSTAT_OUT_RATE", NETSTAT_OUT_RATE )
+	BOOST_END_CLASS()
+
+	BOOST_ENUM( NetStatAggregate )
+		ENUM_VALUE( "NETSTAT_AVG", NETSTAT_AVG )
+		ENUM_VALUE( "NETSTAT_P95", NETSTAT_P95 )
+		ENUM_VALUE( "NETSTAT_MAX", NETSTAT_MAX )
+	BOOST_END_CLASS()
+
+	scope().attr("NETSTAT_HISTORY") = NETSTAT_HISTORY;
+
+	BOOST_ABSTRACT_CLASS(CNetChannelSampler)
+
+		CLASS_PROPERTY_READWRITE(CNetChannelSampler,
+			"interval",
+			get_interval,
+			set_interval,
+			"Returns or sets the number of ticks between two samples. 0 stops sampling."
+		)
+
+		CLASS_METHOD(CNetChannelSampler,
+			get_sample_count,
+			"Returns the number of samples of the player.",
+			args("player_index")
+		)
+
+		CLASS_METHOD(CNetChannelSampler,
+			get_latest,
+			"Returns the newest sample of the metric.",
+			args("player_index", "metric")
+		)
+
+		CLASS_METHOD_OVERLOAD(CNetChannelSampler,
+			get_stats,
+			"Returns (avg, p95, max) over the newest window samples. A window of 0 uses all samples.",
+			args("player_index", "metric", "window")
+		)
+
+		CLASS_METHOD_OVERLOAD(CNetChannelSampler,
+			add_threshold,
+			"Calls callback(index, metric, value) when the aggregate over the newest window samples of a player goes above the value. Players with less than window samples are skipped. Returns the id of the threshold.",
+			args("metric", "value", "callback", "aggregate", "window")
+		)
+
+		CLASS_METHOD(CNetChannelSampler,
+			remove_threshold,
+			"Removes the threshold with the given id.",
+			args("id")
+		)
+
+		CLASS_METHOD(CNetChannelSampler,
+			clear_player,
+			"Drops the samples of the player.",
+			args("player_index")
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_net_channel_sampler,
+		"Returns the CNetChannelSampler instance",
+		reference_existing_object_policy()
+	);
+}
+
+// ----------------------------------------------------------------------------
+// Exports CClientConVarCache.
+// ----------------------------------------------------------------------------
+DECLARE_CLASS_METHOD_OVERLOAD(CClientConVarCache, query, 3, 4);
+
+void export_client_convar_cache()
+{
+	BOOST_ABSTRACT_CLASS(CClientConVarCache)
+
+		CLASS_METHOD(CClientConVarCache,
+			get_value,
+			"Returns the userinfo convar value of the player. Values are cached until the player changes their settings.",
+			args("index", "name")
+		)
+
+		CLASS_METHOD(CClientConVarCache,
+			group_by_value,
+			"Returns a dict {value: [indexes]} with the userinfo convar values of the given players.",
+			args("indexes", "name")
+		)
+
+		CLASS_METHOD_OVERLOAD(CClientConVarCache,
+			query,
+			"Queries every cvar of every player and returns the batch id. The callback is called with a dict {index: {name: value}} once all answers arrived or the timeout expired. Unanswered cvars and bots are None.",
+			args("indexes", "names", "callback", "timeout")
+		)
+
+		CLASS_METHOD(CClientConVarCache,
+			cancel,
+			"Drops the batch without calling its callback.",
+			args("id")
+		)
+
+		CLASS_METHOD(CClientConVarCache,
+			invalidate,
+			"Drops the cached values of the player.",
+			args("index")
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_client_convar_cache,
+		"Returns the CClientConVarCache instance",
+		reference_existing_object_policy()
+	);
+}
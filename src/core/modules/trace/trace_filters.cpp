@@ -0,0 +1,197 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "trace_filters.h"
+#include "utility/sp_team.h"
+#include "utility/sp_util.h"
+#include "utility/wrap_macros.h"
+
+//---------------------------------------------------------------------------------
+// External variables.
+//---------------------------------------------------------------------------------
+extern CGlobalVars* gpGlobals;
+
+//---------------------------------------------------------------------------------
+// CEntityTraceFilter code.
+//---------------------------------------------------------------------------------
+CEntityTraceFilter::CEntityTraceFilter()
+{
+	clear();
+}
+
+void CEntityTraceFilter::ignore( int index )
+{
+	if( index < 0 || index >= MAX_EDICTS )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid entity index.")
+
+	if( !m_Ignored.IsBitSet(index) )
+	{
+		m_Ignored.Set(index);
+		m_iIgnoredCount++;
+	}
+}
+
+void CEntityTraceFilter::unignore( int index )
+{
+	if( index < 0 || index >= MAX_EDICTS )
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid entity index.")
+
+	if( m_Ignored.IsBitSet(index) )
+	{
+		m_Ignored.Clear(index);
+		m_iIgnoredCount--;
+	}
+}
+
+bool CEntityTraceFilter::is_ignored( int index )
+{
+	if( index < 0 || index >= MAX_EDICTS )
+		return false;
+
+	return m_Ignored.IsBitSet(index);
+}
+
+void CEntityTraceFilter::clear_ignored()
+{
+	m_Ignored.ClearAll();
+	m_iIgnoredCount = 0;
+}
+
+void CEntityTraceFilter::allow_classname( const char* classname )
+{
+	m_AllowedClassNames.push_back(classname);
+}
+
+void CEntityTraceFilter::deny_classname( const char* classname )
+{
+	m_DeniedClassNames.push_back(classname);
+}
+
+void CEntityTraceFilter::clear_classnames()
+{
+	m_AllowedClassNames.clear();
+	m_DeniedClassNames.clear();
+}
+
+void CEntityTraceFilter::set_team_only( int team )
+{
+	m_iTeamOnly = team;
+}
+
+int CEntityTraceFilter::get_team_only()
+{
+	return m_iTeamOnly;
+}
+
+void CEntityTraceFilter::set_ignored_team( int team )
+{
+	m_iIgnoredTeam = team;
+}
+
+int CEntityTraceFilter::get_ignored_team()
+{
+	return m_iIgnoredTeam;
+}
+
+void CEntityTraceFilter::set_players_only( bool players_only )
+{
+	m_bPlayersOnly = players_only;
+}
+
+bool CEntityTraceFilter::get_players_only()
+{
+	return m_bPlayersOnly;
+}
+
+void CEntityTraceFilter::clear()
+{
+	clear_ignored();
+	clear_classnames();
+	m_iTeamOnly = 0;
+	m_iIgnoredTeam = 0;
+	m_bPlayersOnly = false;
+}
+
+bool CEntityTraceFilter::ShouldHitEntity( IHandleEntity* pHandleEntity, int contentsMask )
+{
+	if( !pHandleEntity )
+		return true;
+
+	int index = pHandleEntity->GetRefEHandle().GetEntryIndex();
+	if( index == 0 )
+		return true;
+
+	// Static props don't have an entity index.
+	if( index < 0 || index >= MAX_EDICTS )
+		return !m_bPlayersOnly;
+
+	if( m_iIgnoredCount && m_Ignored.IsBitSet(index) )
+		return false;
+
+	if( m_bPlayersOnly && index > gpGlobals->maxClients )
+		return false;
+
+	// All other rules need the edict.
+	if( m_AllowedClassNames.empty() && m_DeniedClassNames.empty() && !m_iTeamOnly && !m_iIgnoredTeam )
+		return true;
+
+	edict_t* pEdict = PEntityOfEntIndex(index);
+	if( !pEdict || pEdict->IsFree() )
+		return true;
+
+	const char* szClassName = pEdict->GetClassName();
+	if( !m_AllowedClassNames.empty() && !has_classname(m_AllowedClassNames, szClassName) )
+		return false;
+
+	if( !m_DeniedClassNames.empty() && has_classname(m_DeniedClassNames, szClassName) )
+		return false;
+
+	if( m_iTeamOnly || m_iIgnoredTeam )
+	{
+		int iTeam = TeamOfEdict(pEdict, index);
+		if( m_iTeamOnly && iTeam != m_iTeamOnly )
+			return false;
+
+		if( m_iIgnoredTeam && iTeam == m_iIgnoredTeam )
+			return false;
+	}
+
+	return true;
+}
+
+bool CEntityTraceFilter::has_classname( const std::vector<std::string>& classnames, const char* szClassName )
+{
+	for( unsigned int i = 0; i < classnames.size(); i++ )
+	{
+		if( V_stricmp(classnames[i].c_str(), szClassName) == 0 )
+			return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,90 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _TRACE_FILTERS_H
+#define _TRACE_FILTERS_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include "edict.h"
+#include "bitvec.h"
+#include "engine/IEngineTrace.h"
+
+//---------------------------------------------------------------------------------
+// Declarative trace filter. The rules are set up once from Python and are
+// evaluated in C++ for every entity a trace touches, so tracing never calls
+// back into Python. The world is always hit.
+//---------------------------------------------------------------------------------
+class CEntityTraceFilter : public CTraceFilter
+{
+public:
+	CEntityTraceFilter();
+
+	// Entities that are never hit.
+	void			ignore( int index );
+	void			unignore( int index );
+	bool			is_ignored( int index );
+	void			clear_ignored();
+
+	// If classnames are allowed, only entities of those classes are hit.
+	// Denied classnames are never hit.
+	void			allow_classname( const char* classname );
+	void			deny_classname( const char* classname );
+	void			clear_classnames();
+
+	// Only hit entities of the given team (0 disables the rule).
+	void			set_team_only( int team );
+	int				get_team_only();
+
+	// Never hit entities of the given team (0 disables the rule).
+	void			set_ignored_team( int team );
+	int				get_ignored_team();
+
+	// Only hit players.
+	void			set_players_only( bool players_only );
+	bool			get_players_only();
+
+	// Removes all rules.
+	void			clear();
+
+	virtual bool	ShouldHitEntity( IHandleEntity* pHandleEntity, int contentsMask );
+
+private:
+	bool			has_classname( const std::vector<std::string>& classnames, const char* szClassName );
+
+private:
+	CBitVec<MAX_EDICTS>			m_Ignored;
+	int							m_iIgnoredCount;
+	std::vector<std::string>	m_AllowedClassNames;
+	std::vector<std::string>	m_DeniedClassNames;
+	int							m_iTeamOnly;
+	int							m_iIgnoredTeam;
+	bool						m_bPlayersOnly;
+};
+
+#endif // _TRACE_FILTERS_H
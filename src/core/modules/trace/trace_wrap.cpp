@@ -0,0 +1,254 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "trace_wrap.h"
+#include "gametrace.h"
+#include "utility/sp_util.h"
+#include "utility/wrap_macros.h"
+
+//---------------------------------------------------------------------------------
+// External variables.
+//---------------------------------------------------------------------------------
+extern IEngineTrace* enginetrace;
+
+//---------------------------------------------------------------------------------
+// Static singletons.
+//---------------------------------------------------------------------------------
+static CEngineTrace s_EngineTrace;
+
+//---------------------------------------------------------------------------------
+// EngineTrace accessor.
+//---------------------------------------------------------------------------------
+CEngineTrace* get_engine_trace()
+{
+	return &s_EngineTrace;
+}
+
+//---------------------------------------------------------------------------------
+// Converts a CVector or a sequence of three floats to a Vector.
+//---------------------------------------------------------------------------------
+static Vector ExtractVector( object obj )
+{
+	extract<CVector *> vector(obj);
+	if( vector.check() )
+		return *vector();
+
+	return Vector(extract<float>(obj[0]), extract<float>(obj[1]), extract<float>(obj[2]));
+}
+
+//---------------------------------------------------------------------------------
+// Returns the filter of a trace call. Sequences of entity indexes to ignore are
+// stored in the given temporary filter.
+//---------------------------------------------------------------------------------
+static CEntityTraceFilter* ExtractTraceFilter( object filter, CEntityTraceFilter& tempFilter )
+{
+	if( filter.is_none() )
+		return &tempFilter;
+
+	extract<CEntityTraceFilter *> traceFilter(filter);
+	if( traceFilter.check() )
+		return traceFilter();
+
+	extract<int> index(filter);
+	if( index.check() )
+	{
+		tempFilter.ignore(index());
+		return &tempFilter;
+	}
+
+	int iLength = len(filter);
+	for( int i = 0; i < iLength; i++ )
+	{
+		tempFilter.ignore(extract<int>(filter[i]));
+	}
+
+	return &tempFilter;
+}
+
+//---------------------------------------------------------------------------------
+// Returns the index of the entity that was hit, or -1 if nothing or a
+// non-networked object was hit. The world is 0.
+//---------------------------------------------------------------------------------
+static int IndexOfTraceEntity( const trace_t& tr )
+{
+	edict_t* pEdict = EdictOfBaseEntity(tr.m_pEnt);
+	return pEdict ? IndexOfEdict(pEdict) : -1;
+}
+
+//---------------------------------------------------------------------------------
+// CTraceResults code.
+//---------------------------------------------------------------------------------
+CTraceResults::CTraceResults( int iCount )
+{
+	m_Fractions.resize(iCount);
+	m_EndPositions.resize(iCount);
+	m_EntityIndexes.resize(iCount);
+	m_PlaneNormals.resize(iCount);
+}
+
+int CTraceResults::get_count()
+{
+	return (int) m_Fractions.size();
+}
+
+boost::python::list CTraceResults::get_fractions()
+{
+	boost::python::list fractions;
+	for( unsigned int i = 0; i < m_Fractions.size(); i++ )
+	{
+		fractions.append(m_Fractions[i]);
+	}
+
+	return fractions;
+}
+
+boost::python::list CTraceResults::get_end_positions()
+{
+	boost::python::list positions;
+	for( unsigned int i = 0; i < m_EndPositions.size(); i++ )
+	{
+		positions.append(CVector(m_EndPositions[i]));
+	}
+
+	return positions;
+}
+
+boost::python::list CTraceResults::get_entity_indexes()
+{
+	boost::python::list indexes;
+	for( unsigned int i = 0; i < m_EntityIndexes.size(); i++ )
+	{
+		indexes.append(m_EntityIndexes[i]);
+	}
+
+	return indexes;
+}
+
+boost::python::list CTraceResults::get_plane_normals()
+{
+	boost::python::list normals;
+	for( unsigned int i = 0; i < m_PlaneNormals.size(); i++ )
+	{
+		normals.append(CVector(m_PlaneNormals[i]));
+	}
+
+	return normals;
+}
+
+void CTraceResults::set_result( int iRow, const trace_t& tr )
+{
+	m_Fractions[iRow] = tr.fraction;
+	m_EndPositions[iRow] = tr.endpos;
+	m_PlaneNormals[iRow] = tr.plane.normal;
+
+	m_EntityIndexes[iRow] = IndexOfTraceEntity(tr);
+}
+
+//---------------------------------------------------------------------------------
+// CEngineTrace code.
+//---------------------------------------------------------------------------------
+boost::python::tuple CEngineTrace::trace_ray( object start, object end, unsigned int mask, object filter /* = object() */,
+	object mins /* = object() */, object maxs /* = object() */ )
+{
+	if( !enginetrace )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "The engine trace interface is not available.")
+
+	if( mins.is_none() != maxs.is_none() )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Hull mins and maxs must be given together.")
+
+	CEntityTraceFilter tempFilter;
+	CEntityTraceFilter* pFilter = ExtractTraceFilter(filter, tempFilter);
+
+	Ray_t ray;
+	if( mins.is_none() )
+		ray.Init(ExtractVector(start), ExtractVector(end));
+	else
+		ray.Init(ExtractVector(start), ExtractVector(end), ExtractVector(mins), ExtractVector(maxs));
+
+	trace_t tr;
+	enginetrace->TraceRay(ray, mask, pFilter, &tr);
+
+	return boost::python::make_tuple(
+		tr.fraction,
+		CVector(tr.endpos),
+		IndexOfTraceEntity(tr),
+		CVector(tr.plane.normal)
+	);
+}
+
+CTraceResults* CEngineTrace::trace_ray_batch( object starts, object ends, unsigned int mask, object filter /* = object() */,
+	object mins /* = object() */, object maxs /* = object() */ )
+{
+	if( !enginetrace )
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "The engine trace interface is not available.")
+
+	int iCount = len(starts);
+	if( len(ends) != iCount )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "The number of start and end points doesn't match.")
+
+	if( mins.is_none() != maxs.is_none() )
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Hull mins and maxs must be given together.")
+
+	CEntityTraceFilter tempFilter;
+	CEntityTraceFilter* pFilter = ExtractTraceFilter(filter, tempFilter);
+
+	// Convert all points before the first ray is traced.
+	std::vector<Vector> vecStarts(iCount);
+	std::vector<Vector> vecEnds(iCount);
+	for( int i = 0; i < iCount; i++ )
+	{
+		vecStarts[i] = ExtractVector(starts[i]);
+		vecEnds[i] = ExtractVector(ends[i]);
+	}
+
+	bool bHull = !mins.is_none();
+	Vector vecMins, vecMaxs;
+	if( bHull )
+	{
+		vecMins = ExtractVector(mins);
+		vecMaxs = ExtractVector(maxs);
+	}
+
+	CTraceResults* pResults = new CTraceResults(iCount);
+
+	Ray_t ray;
+	trace_t tr;
+	for( int i = 0; i < iCount; i++ )
+	{
+		if( bHull )
+			ray.Init(vecStarts[i], vecEnds[i], vecMins, vecMaxs);
+		else
+			ray.Init(vecStarts[i], vecEnds[i]);
+
+		enginetrace->TraceRay(ray, mask, pFilter, &tr);
+		pResults->set_result(i, tr);
+	}
+
+	return pResults;
+}
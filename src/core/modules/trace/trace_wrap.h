@@ -0,0 +1,84 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+#ifndef _TRACE_WRAP_H
+#define _TRACE_WRAP_H
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include <vector>
+#include "edict.h"
+#include "engine/IEngineTrace.h"
+#include "trace_filters.h"
+#include "modules/vecmath/vecmath_wrap.h"
+
+//---------------------------------------------------------------------------------
+// Columns of a batch trace. Row i holds the result of the i-th ray.
+//---------------------------------------------------------------------------------
+class CTraceResults
+{
+public:
+	CTraceResults( int iCount );
+
+	int		get_count();
+
+	boost::python::list	get_fractions();
+	boost::python::list	get_end_positions();
+	boost::python::list	get_entity_indexes();
+	boost::python::list	get_plane_normals();
+
+	// Stores the result of a single ray.
+	void	set_result( int iRow, const trace_t& tr );
+
+private:
+	std::vector<float>		m_Fractions;
+	std::vector<Vector>		m_EndPositions;
+	std::vector<int>		m_EntityIndexes;
+	std::vector<Vector>		m_PlaneNormals;
+};
+
+//---------------------------------------------------------------------------------
+// Traces rays through the world. Batches run all TraceRay calls in C++, so a
+// whole set of line of sight checks costs a single call from Python.
+//---------------------------------------------------------------------------------
+class CEngineTrace
+{
+public:
+	// Returns (fraction, end_position, entity_index, plane_normal) of one ray.
+	// The filter is None, a CEntityTraceFilter or a sequence of entity indexes
+	// to ignore.
+	boost::python::tuple	trace_ray( object start, object end, unsigned int mask, object filter = object(),
+								object mins = object(), object maxs = object() );
+
+	// Traces a ray from every start point to the end point with the same index.
+	// If mins and maxs are given, every ray is swept as a hull of that size.
+	CTraceResults*			trace_ray_batch( object starts, object ends, unsigned int mask, object filter = object(),
+								object mins = object(), object maxs = object() );
+};
+
+CEngineTrace* get_engine_trace();
+
+#endif // _TRACE_WRAP_H
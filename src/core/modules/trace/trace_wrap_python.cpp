@@ -0,0 +1,212 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "modules/export_main.h"
+#include "trace_wrap.h"
+#include "bspflags.h"
+
+//---------------------------------------------------------------------------------
+// Exposer functions.
+//---------------------------------------------------------------------------------
+void export_engine_trace();
+void export_trace_results();
+void export_trace_masks();
+void export_entity_trace_filter();
+
+//---------------------------------------------------------------------------------
+// Exposes the trace_c module.
+//---------------------------------------------------------------------------------
+DECLARE_SP_MODULE(trace_c)
+{
+	export_entity_trace_filter();
+	export_trace_results();
+	export_engine_trace();
+	export_trace_masks();
+}
+
+//---------------------------------------------------------------------------------
+// Exposes the common trace masks of the engine.
+//---------------------------------------------------------------------------------
+void export_trace_masks()
+{
+	scope().attr("MASK_ALL") = (unsigned int) MASK_ALL;
+	scope().attr("MASK_SOLID") = MASK_SOLID;
+	scope().attr("MASK_PLAYERSOLID") = MASK_PLAYERSOLID;
+	scope().attr("MASK_NPCSOLID") = MASK_NPCSOLID;
+	scope().attr("MASK_OPAQUE") = MASK_OPAQUE;
+	scope().attr("MASK_VISIBLE") = MASK_VISIBLE;
+	scope().attr("MASK_SHOT") = MASK_SHOT;
+	scope().attr("MASK_SHOT_HULL") = MASK_SHOT_HULL;
+}
+
+//---------------------------------------------------------------------------------
+// Exposes CEntityTraceFilter.
+//---------------------------------------------------------------------------------
+void export_entity_trace_filter()
+{
+	BOOST_CLASS(CEntityTraceFilter)
+
+		CLASS_METHOD(CEntityTraceFilter,
+			ignore,
+			"Never hit the entity with the given index.",
+			args("index")
+		)
+
+		CLASS_METHOD(CEntityTraceFilter,
+			unignore,
+			"Hits the entity with the given index again.",
+			args("index")
+		)
+
+		CLASS_METHOD(CEntityTraceFilter,
+			is_ignored,
+			"Returns True if the entity with the given index is ignored.",
+			args("index")
+		)
+
+		CLASS_METHOD(CEntityTraceFilter,
+			clear_ignored,
+			"Removes all ignored entities."
+		)
+
+		CLASS_METHOD(CEntityTraceFilter,
+			allow_classname,
+			"Only hit entities of the allowed classnames.",
+			args("classname")
+		)
+
+		CLASS_METHOD(CEntityTraceFilter,
+			deny_classname,
+			"Never hit entities of the given classname.",
+			args("classname")
+		)
+
+		CLASS_METHOD(CEntityTraceFilter,
+			clear_classnames,
+			"Removes all allowed and denied classnames."
+		)
+
+		CLASS_METHOD(CEntityTraceFilter,
+			clear,
+			"Removes all rules."
+		)
+
+		CLASS_PROPERTY_READWRITE(CEntityTraceFilter,
+			"team_only",
+			get_team_only,
+			set_team_only,
+			"Only hit entities of this team (0 disables the rule)."
+		)
+
+		CLASS_PROPERTY_READWRITE(CEntityTraceFilter,
+			"ignored_team",
+			get_ignored_team,
+			set_ignored_team,
+			"Never hit entities of this team (0 disables the rule)."
+		)
+
+		CLASS_PROPERTY_READWRITE(CEntityTraceFilter,
+			"players_only",
+			get_players_only,
+			set_players_only,
+			"Only hit players. The world is always hit."
+		)
+
+	BOOST_END_CLASS()
+}
+
+//---------------------------------------------------------------------------------
+// Exposes CTraceResults.
+//---------------------------------------------------------------------------------
+void export_trace_results()
+{
+	BOOST_ABSTRACT_CLASS(CTraceResults)
+
+		CLASS_PROPERTY_READ_ONLY(CTraceResults,
+			"fractions",
+			get_fractions,
+			"Returns the hit fraction of every ray (1.0 means nothing was hit)."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CTraceResults,
+			"end_positions",
+			get_end_positions,
+			"Returns the end position of every ray."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CTraceResults,
+			"entity_indexes",
+			get_entity_indexes,
+			"Returns the index of the entity every ray hit or -1."
+		)
+
+		CLASS_PROPERTY_READ_ONLY(CTraceResults,
+			"plane_normals",
+			get_plane_normals,
+			"Returns the normal of the plane every ray hit."
+		)
+
+		CLASS_METHOD_SPECIAL(CTraceResults,
+			"__len__",
+			get_count
+		)
+
+	BOOST_END_CLASS()
+}
+
+//---------------------------------------------------------------------------------
+// Exposes CEngineTrace.
+//---------------------------------------------------------------------------------
+DECLARE_CLASS_METHOD_OVERLOAD(CEngineTrace, trace_ray, 3, 6);
+DECLARE_CLASS_METHOD_OVERLOAD(CEngineTrace, trace_ray_batch, 3, 6);
+
+void export_engine_trace()
+{
+	BOOST_ABSTRACT_CLASS(CEngineTrace)
+
+		CLASS_METHOD_OVERLOAD(CEngineTrace,
+			trace_ray,
+			"Traces a ray and returns (fraction, end_position, entity_index, plane_normal). The filter is None, a CEntityTraceFilter or the entity indexes to ignore. If mins and maxs are given, a hull is traced.",
+			args("start", "end", "mask", "filter", "mins", "maxs")
+		)
+
+		CLASS_METHOD_OVERLOAD_RET(CEngineTrace,
+			trace_ray_batch,
+			"Traces a ray from every start point to the end point with the same index and returns a CTraceResults instance.",
+			args("starts", "ends", "mask", "filter", "mins", "maxs"),
+			manage_new_object_policy()
+		)
+
+	BOOST_END_CLASS()
+
+	BOOST_FUNCTION(get_engine_trace,
+		"Returns the CEngineTrace instance",
+		reference_existing_object_policy()
+	);
+}
@@ -37,8 +37,9 @@ using namespace boost::python;
 // next() should bind to the magic method __next__().
 //
 // Implementation Details:
-// Implement getNext() to return the next object in the sequence.
-// Returning NULL in getNext() will mean the generator will raise a StopIteration.
+// Implement getNext() to return the next object (of type T) in the sequence.
+// Returning None in getNext() will mean the generator will raise a StopIteration.
+// Objects are returned as Python objects, so cached instances keep their identity.
 //---------------------------------------------------------------------------------
 template<class T>
 class IPythonGenerator
@@ -47,9 +48,9 @@ public:
 	IPythonGenerator(PyObject* self);
 	virtual ~IPythonGenerator() = 0;
 	handle<> iter();
-	T* next();
+	object next();
 protected:
-	virtual T* getNext() = 0;
+	virtual object getNext() = 0;
 	IPythonGenerator(const IPythonGenerator& rhs);
 private:
 	PyObject* m_pSelf;
@@ -92,19 +93,19 @@ handle<> IPythonGenerator<T>::iter()
 
 //---------------------------------------------------------------------------------
 // Maps to __next__(). Calls getNext() and returns the next object, or raises
-// StopIteration if getNext() returned NULL.
+// StopIteration if getNext() returned None.
 //---------------------------------------------------------------------------------
 template<class T>
-T* IPythonGenerator<T>::next()
+object IPythonGenerator<T>::next()
 {
-	T* pValue = getNext();
-	if (!pValue)
+	object value = getNext();
+	if (value.is_none())
 	{
 		BOOST_RAISE_EXCEPTION(PyExc_StopIteration, "Iteration stops here.");
-		return NULL;
+		return object();
 	}
 
-	return pValue;
+	return value;
 }
 
 //---------------------------------------------------------------------------------
@@ -122,8 +123,7 @@ T* IPythonGenerator<T>::next()
 		CLASS_METHOD_SPECIAL(classname, \
 			"__next__", \
 			next, \
-			"Returns the next valid instance.", \
-			reference_existing_object_policy() \
+			"Returns the next valid instance." \
 		)
 
 #endif // _PYTHON_GENERATOR_H
@@ -0,0 +1,61 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//---------------------------------------------------------------------------------
+// Includes
+//---------------------------------------------------------------------------------
+#include "sp_team.h"
+#include "game/server/iplayerinfo.h"
+#include "modules/entities/entities_datamaps.h"
+#include "utility/sp_util.h"
+
+//---------------------------------------------------------------------------------
+// External variables.
+//---------------------------------------------------------------------------------
+extern CGlobalVars* gpGlobals;
+
+//---------------------------------------------------------------------------------
+// Returns the team of an entity.
+//---------------------------------------------------------------------------------
+int TeamOfEdict( edict_t* pEdict, int index )
+{
+	if( index > 0 && index <= gpGlobals->maxClients )
+	{
+		IPlayerInfo* pPlayerInfo = PlayerOfIndex(index);
+		return pPlayerInfo ? pPlayerInfo->GetTeamIndex() : 0;
+	}
+
+	// Other entities store their team in the datamap.
+	CDataMapTable* pTable = UTIL_GetDataMapTable(pEdict);
+	if( !pTable )
+		return 0;
+
+	const CDataMapOffset* pField = pTable->get_offset("m_iTeamNum");
+	if( !pField )
+		return 0;
+
+	return *(int *) ((char *) pEdict->GetUnknown()->GetBaseEntity() + pField->offset);
+}
@@ -95,22 +95,7 @@ inline edict_t* PEntityOfEntIndex(int iEntIndex)
 //---------------------------------------------------------------------------------
 // Returns the edict instance given a userid.
 //---------------------------------------------------------------------------------
-inline edict_t* EdictOfUserid(int userid)
-{
-	edict_t* pEdict;
-	for(int i=1; i <= gpGlobals->maxClients; ++i)
-	{
-		pEdict = PEntityOfEntIndex(i);
-		if (pEdict && !pEdict->IsFree() &&
-			strcmp(pEdict->GetClassName(), "player") == 0 &&
-			engine->GetPlayerUserId(pEdict) == userid)
-		{
-			return pEdict;
-		}
-	}
-
-	return NULL;
-}
+edict_t* EdictOfUserid(int userid);
 
 //---------------------------------------------------------------------------------
 // Returns the playerinfo instance given a userid.
@@ -173,35 +158,58 @@ inline edict_t* EdictOfPlayer(IPlayerInfo* playerInfo)
 }
 
 //---------------------------------------------------------------------------------
-// Returns the index of a handle from integer form
+// Returns the index of a handle from integer form or -1 if the handle is stale.
+// The serial number is checked against the entity's own handle, which only
+// costs a single virtual call.
 //---------------------------------------------------------------------------------
-inline unsigned int IndexOfIntHandle(int iHandle)
+inline int ResolveIntHandle(int iHandle)
 {
 	CBaseHandle hHandle(iHandle);
-	unsigned int iIndex = hHandle.GetEntryIndex();
-	edict_t *pEntity = PEntityOfEntIndex(iIndex);
-	if (!pEntity || pEntity->IsFree())
+	if (!hHandle.IsValid())
 	{
-		return NULL;
+		return -1;
 	}
-	IServerNetworkable *pNetworkable = pEntity->GetNetworkable();
-	IHandleEntity *pEnt = pNetworkable->GetEntityHandle();
-	if (!pEnt)
+	int iIndex = hHandle.GetEntryIndex();
+	edict_t *pEntity = PEntityOfEntIndex(iIndex);
+	if (!pEntity || pEntity->IsFree())
 	{
-		return NULL;
+		return -1;
 	}
-	const CBaseHandle hTestHandle = pEnt->GetRefEHandle();
-	if (!hTestHandle.IsValid())
+	IServerUnknown *pUnknown = pEntity->GetUnknown();
+	if (!pUnknown)
 	{
-		return NULL;
+		return -1;
 	}
-	if (hHandle.GetSerialNumber() != hTestHandle.GetSerialNumber())
+	if (hHandle.GetSerialNumber() != pUnknown->GetRefEHandle().GetSerialNumber())
 	{
-		return NULL;
+		return -1;
 	}
 	return iIndex;
 }
 
+//---------------------------------------------------------------------------------
+// Returns the index of a handle from integer form or -1 if the handle is stale.
+//---------------------------------------------------------------------------------
+inline int IndexOfIntHandle(int iHandle)
+{
+	return ResolveIntHandle(iHandle);
+}
+
+//---------------------------------------------------------------------------------
+// Returns the edict of a CBaseEntity pointer, or NULL if it isn't networked.
+//---------------------------------------------------------------------------------
+inline edict_t* EdictOfBaseEntity(void* pEntity)
+{
+	if (!pEntity)
+		return NULL;
+
+	IServerNetworkable* pNetworkable = ((IServerUnknown *) pEntity)->GetNetworkable();
+	if (!pNetworkable)
+		return NULL;
+
+	return pNetworkable->GetEdict();
+}
+
 //---------------------------------------------------------------------------------
 // Returns the index of a pointer
 //---------------------------------------------------------------------------------